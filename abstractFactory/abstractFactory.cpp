@@ -1,101 +1,9 @@
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <string>
 
-/*
- * Product A
- * products implement the same interface so that the classes can refer
- * to the interface not the concrete product
- */
-class AbstractProductA {
-   public:
-    virtual ~AbstractProductA() = default;
-
-    virtual std::string getName() const = 0;
-    // ...
-};
-
-/*
- * ConcreteProductAX and ConcreteProductAY
- * define objects to be created by concrete factory
- */
-class ConcreteProductAX : public AbstractProductA {
-   public:
-    std::string getName() const override { return "AX"; }
-    // ...
-};
-
-class ConcreteProductAY : public AbstractProductA {
-   public:
-    std::string getName() const override { return "AY"; }
-    // ...
-};
-
-/*
- * Product B
- * same as Product A, Product B declares interface for concrete products
- * where each can produce an entire set of products
- */
-class AbstractProductB {
-   public:
-    virtual ~AbstractProductB() = default;
-
-    virtual std::string getName() const = 0;
-};
-
-/*
- * ConcreteProductBX and ConcreteProductBY
- * same as previous concrete product classes
- */
-class ConcreteProductBX : public AbstractProductB {
-   public:
-    std::string getName() const override { return "BX"; }
-    // ...
-};
-
-class ConcreteProductBY : public AbstractProductB {
-   public:
-    std::string getName() const override { return "BY"; }
-    // ...
-};
-
-/*
- * Abstract Factory
- * provides an abstract interface for creating a family of products
- */
-class AbstractFactory {
-   public:
-    virtual ~AbstractFactory() = default;
-
-    virtual std::shared_ptr<AbstractProductA> createProductA() const = 0;
-    virtual std::shared_ptr<AbstractProductB> createProductB() const = 0;
-};
-
-/*
- * Concrete Factory X and Y
- * each concrete factory create a family of products and client uses
- * one of these factories so it never has to instantiate a product object
- */
-class ConcreteFactoryX : public AbstractFactory {
-   public:
-    std::shared_ptr<AbstractProductA> createProductA() const override {
-        return std::make_shared<ConcreteProductAX>();
-    }
-    std::shared_ptr<AbstractProductB> createProductB() const override {
-        return std::make_shared<ConcreteProductBX>();
-    }
-    // ...
-};
-
-class ConcreteFactoryY : public AbstractFactory {
-   public:
-    std::shared_ptr<AbstractProductA> createProductA() const override {
-        return std::make_shared<ConcreteProductAY>();
-    }
-    std::shared_ptr<AbstractProductB> createProductB() const override {
-        return std::make_shared<ConcreteProductBY>();
-    }
-    // ...
-};
+#include "abstractFactory.h"
 
 int main() {
     auto factoryX = std::make_shared<ConcreteFactoryX>();
@@ -106,4 +14,20 @@ int main() {
 
     std::shared_ptr<AbstractProductB> p2 = factoryY->createProductB();
     std::cout << "Product: " << p2->getName() << "\n";
+
+    ProductBlock<AbstractProductA> batch = factoryY->createProductsA(3);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        std::cout << "Batch product: " << batch[i].getName() << "\n";
+
+    Factory<FamilyX> staticFactory;
+    ConcreteProductBX p3 = staticFactory.createProductB();
+    std::cout << "Static product: " << p3.getName() << "\n";
+
+    std::shared_ptr<AbstractFactory> runtimeFactory = Factory<FamilyY>::runtime();
+    std::cout << "Runtime product: " << runtimeFactory->createProductA()->getName()
+              << "\n";
+
+    VariantFactory variantFactory(Family::Y);
+    ProductBVariant p4 = variantFactory.createProductB();
+    std::cout << "Variant product: " << getName(p4) << "\n";
 }
\ No newline at end of file
@@ -0,0 +1,249 @@
+#ifndef ABSTRACT_FACTORY_ABSTRACT_FACTORY_H
+#define ABSTRACT_FACTORY_ABSTRACT_FACTORY_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "slab_pool.h"
+
+/*
+ * Product A
+ * products implement the same interface so that the classes can refer
+ * to the interface not the concrete product
+ */
+class AbstractProductA {
+   public:
+    virtual ~AbstractProductA() = default;
+
+    virtual std::string getName() const = 0;
+    // ...
+};
+
+/*
+ * ConcreteProductAX and ConcreteProductAY
+ * define objects to be created by concrete factory; they are final so
+ * calls on a statically known product are devirtualized
+ */
+class ConcreteProductAX final : public AbstractProductA {
+   public:
+    std::string getName() const override { return "AX"; }
+    // ...
+};
+
+class ConcreteProductAY final : public AbstractProductA {
+   public:
+    std::string getName() const override { return "AY"; }
+    // ...
+};
+
+/*
+ * Product B
+ * same as Product A, Product B declares interface for concrete products
+ * where each can produce an entire set of products
+ */
+class AbstractProductB {
+   public:
+    virtual ~AbstractProductB() = default;
+
+    virtual std::string getName() const = 0;
+};
+
+/*
+ * ConcreteProductBX and ConcreteProductBY
+ * same as previous concrete product classes
+ */
+class ConcreteProductBX final : public AbstractProductB {
+   public:
+    std::string getName() const override { return "BX"; }
+    // ...
+};
+
+class ConcreteProductBY final : public AbstractProductB {
+   public:
+    std::string getName() const override { return "BY"; }
+    // ...
+};
+
+/*
+ * Product Block
+ * owns n concrete products constructed in one contiguous allocation
+ * and exposes them through their abstract interface
+ */
+template <typename AbstractProduct>
+class ProductBlock {
+   public:
+    template <typename ConcreteProduct>
+    static ProductBlock create(std::size_t n) {
+        ProductBlock block;
+        block.products = std::shared_ptr<void>(
+            new ConcreteProduct[n],
+            [](void *p) { delete[] static_cast<ConcreteProduct *>(p); });
+        block.count = n;
+        block.at = [](void *p, std::size_t i) -> AbstractProduct * {
+            return static_cast<ConcreteProduct *>(p) + i;
+        };
+        return block;
+    }
+
+    std::size_t size() const { return count; }
+    AbstractProduct &operator[](std::size_t i) const {
+        return *at(products.get(), i);
+    }
+
+   private:
+    ProductBlock() = default;
+
+    std::shared_ptr<void> products;
+    std::size_t count = 0;
+    AbstractProduct *(*at)(void *, std::size_t) = nullptr;
+};
+
+/*
+ * Abstract Factory
+ * provides an abstract interface for creating a family of products
+ */
+class AbstractFactory {
+   public:
+    virtual ~AbstractFactory() = default;
+
+    virtual std::shared_ptr<AbstractProductA> createProductA() const = 0;
+    virtual std::shared_ptr<AbstractProductB> createProductB() const = 0;
+
+    virtual ProductBlock<AbstractProductA> createProductsA(
+        std::size_t n) const = 0;
+    virtual ProductBlock<AbstractProductB> createProductsB(
+        std::size_t n) const = 0;
+};
+
+/*
+ * Concrete Factory X and Y
+ * each concrete factory create a family of products and client uses
+ * one of these factories so it never has to instantiate a product object;
+ * single products are drawn from per-factory pools and go back to them
+ * when released
+ */
+class ConcreteFactoryX : public AbstractFactory {
+   public:
+    std::shared_ptr<AbstractProductA> createProductA() const override {
+        return std::allocate_shared<ConcreteProductAX>(
+            PoolAllocator<ConcreteProductAX>(poolA.get()));
+    }
+    std::shared_ptr<AbstractProductB> createProductB() const override {
+        return std::allocate_shared<ConcreteProductBX>(
+            PoolAllocator<ConcreteProductBX>(poolB.get()));
+    }
+
+    ProductBlock<AbstractProductA> createProductsA(
+        std::size_t n) const override {
+        return ProductBlock<AbstractProductA>::create<ConcreteProductAX>(n);
+    }
+    ProductBlock<AbstractProductB> createProductsB(
+        std::size_t n) const override {
+        return ProductBlock<AbstractProductB>::create<ConcreteProductBX>(n);
+    }
+    // ...
+
+   private:
+    std::unique_ptr<SlabPool, SlabPool::Retire> poolA{new SlabPool};
+    std::unique_ptr<SlabPool, SlabPool::Retire> poolB{new SlabPool};
+};
+
+class ConcreteFactoryY : public AbstractFactory {
+   public:
+    std::shared_ptr<AbstractProductA> createProductA() const override {
+        return std::allocate_shared<ConcreteProductAY>(
+            PoolAllocator<ConcreteProductAY>(poolA.get()));
+    }
+    std::shared_ptr<AbstractProductB> createProductB() const override {
+        return std::allocate_shared<ConcreteProductBY>(
+            PoolAllocator<ConcreteProductBY>(poolB.get()));
+    }
+
+    ProductBlock<AbstractProductA> createProductsA(
+        std::size_t n) const override {
+        return ProductBlock<AbstractProductA>::create<ConcreteProductAY>(n);
+    }
+    ProductBlock<AbstractProductB> createProductsB(
+        std::size_t n) const override {
+        return ProductBlock<AbstractProductB>::create<ConcreteProductBY>(n);
+    }
+    // ...
+
+   private:
+    std::unique_ptr<SlabPool, SlabPool::Retire> poolA{new SlabPool};
+    std::unique_ptr<SlabPool, SlabPool::Retire> poolB{new SlabPool};
+};
+
+/*
+ * Product Families
+ * describe a family at compile time: its concrete products and the
+ * factory to use where the family is only known at runtime
+ */
+struct FamilyX {
+    using ProductA = ConcreteProductAX;
+    using ProductB = ConcreteProductBX;
+    using RuntimeFactory = ConcreteFactoryX;
+};
+
+struct FamilyY {
+    using ProductA = ConcreteProductAY;
+    using ProductB = ConcreteProductBY;
+    using RuntimeFactory = ConcreteFactoryY;
+};
+
+/*
+ * Static Factory
+ * creates products of a compile-time family by value, so there is no
+ * heap allocation and every call on the product can be inlined;
+ * runtime() hands out the matching AbstractFactory for code that
+ * selects the family at runtime
+ */
+template <typename Family>
+class Factory {
+   public:
+    using ProductA = typename Family::ProductA;
+    using ProductB = typename Family::ProductB;
+
+    ProductA createProductA() const { return ProductA{}; }
+    ProductB createProductB() const { return ProductB{}; }
+
+    static std::shared_ptr<AbstractFactory> runtime() {
+        return std::make_shared<typename Family::RuntimeFactory>();
+    }
+};
+
+/*
+ * Variant Factory
+ * selects the family at runtime but still returns products by value,
+ * dispatching through std::visit instead of a heap allocated product
+ */
+using ProductAVariant = std::variant<ConcreteProductAX, ConcreteProductAY>;
+using ProductBVariant = std::variant<ConcreteProductBX, ConcreteProductBY>;
+
+enum class Family { X, Y };
+
+class VariantFactory {
+   public:
+    explicit VariantFactory(Family family) : family(family) {}
+
+    ProductAVariant createProductA() const {
+        if (family == Family::X) return Factory<FamilyX>().createProductA();
+        return Factory<FamilyY>().createProductA();
+    }
+    ProductBVariant createProductB() const {
+        if (family == Family::X) return Factory<FamilyX>().createProductB();
+        return Factory<FamilyY>().createProductB();
+    }
+
+   private:
+    Family family;
+};
+
+template <typename... Products>
+std::string getName(const std::variant<Products...> &product) {
+    return std::visit([](const auto &p) { return p.getName(); }, product);
+}
+
+#endif
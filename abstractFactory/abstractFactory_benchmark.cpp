@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstractFactory.h"
+
+/*
+ * Benchmark of product creation in Abstract Factory:
+ * std::make_shared per product against ConcreteFactoryX's slab-pooled
+ * createProductA() and its bulk createProductsA(); products are kept
+ * alive in small windows so the pool gets to recycle released blocks
+ */
+template <typename Function>
+double measure(const char *name, std::size_t iterations, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    std::size_t checksum = function(iterations);
+    auto stop = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count() /
+                static_cast<double>(iterations);
+    std::cout << name << ": " << ns << " ns/product (checksum " << checksum
+              << ")\n";
+    return ns;
+}
+
+int main() {
+    const std::size_t iterations = 2000000;
+    const std::size_t window = 64;
+
+    measure("make_shared", iterations, [window](std::size_t n) {
+        std::vector<std::shared_ptr<AbstractProductA>> live(window);
+        std::size_t checksum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            live[i % window] = std::make_shared<ConcreteProductAX>();
+            checksum += live[i % window]->getName().size();
+        }
+        return checksum;
+    });
+
+    std::shared_ptr<AbstractFactory> factory =
+        std::make_shared<ConcreteFactoryX>();
+    measure("pooled createProductA", iterations, [&](std::size_t n) {
+        std::vector<std::shared_ptr<AbstractProductA>> live(window);
+        std::size_t checksum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            live[i % window] = factory->createProductA();
+            checksum += live[i % window]->getName().size();
+        }
+        return checksum;
+    });
+
+    measure("bulk createProductsA", iterations, [&](std::size_t n) {
+        std::size_t checksum = 0;
+        for (std::size_t i = 0; i < n; i += window) {
+            ProductBlock<AbstractProductA> block =
+                factory->createProductsA(window);
+            for (std::size_t j = 0; j < block.size(); ++j)
+                checksum += block[j].getName().size();
+        }
+        return checksum;
+    });
+}
@@ -0,0 +1,244 @@
+#ifndef ABSTRACT_FACTORY_SLAB_POOL_H
+#define ABSTRACT_FACTORY_SLAB_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/*
+ * Slab Pool
+ * hands out fixed-size blocks carved from larger slabs and keeps released
+ * blocks on a free list, so products are recycled instead of going back
+ * to the heap; the block size is fixed by the first request and bigger
+ * requests fall through to operator new
+ *
+ * every thread keeps its own cache of blocks per pool, so allocate and
+ * deallocate take no lock; the shared free list is only locked to move
+ * a batch of blocks into a cache that ran dry or out of one that
+ * overflowed, and a thread that exits hands its cached blocks back
+ *
+ * products may outlive their factory, so the owner retires the pool
+ * instead of deleting it and the pool frees itself once the last
+ * outstanding block has come back; blocks released after retirement go
+ * straight back to the pool, while blocks another thread cached before
+ * it come back when that thread exits
+ */
+class SlabPool {
+   public:
+    struct Retire {
+        void operator()(SlabPool *pool) const { pool->retire(); }
+    };
+
+    static constexpr std::size_t batchSize = 32;
+    static constexpr std::size_t cacheLimit = 2 * batchSize;
+
+    explicit SlabPool(std::size_t blocksPerSlab = 256)
+        : blocksPerSlab(blocksPerSlab) {}
+
+    SlabPool(SlabPool const &) = delete;
+    SlabPool &operator=(SlabPool const &) = delete;
+
+    void *allocate(std::size_t size) {
+        Entry &entry = cached();
+        // a cache only holds blocks once blockSize is set
+        if (entry.head == nullptr || size > blockSize)
+            return refill(entry, size);
+
+        Block *block = entry.head;
+        entry.head = block->next;
+        --entry.count;
+        return block;
+    }
+
+    void deallocate(void *p, std::size_t size) {
+        if (size > blockSize || retired.load(std::memory_order_acquire)) {
+            release(p, size);
+            return;
+        }
+
+        Entry &entry = cached();
+        Block *block = static_cast<Block *>(p);
+        block->next = entry.head;
+        entry.head = block;
+        if (++entry.count > cacheLimit) giveBack(entry, batchSize);
+    }
+
+    void retire() {
+        Entry &entry = cached();
+        if (entry.count > 0) giveBack(entry, entry.count);
+
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            retired.store(true, std::memory_order_release);
+            last = outstanding == 0;
+        }
+        if (last) delete this;
+    }
+
+   private:
+    struct Block {
+        Block *next;
+    };
+
+    // one thread's blocks of one pool; outstanding counts them as handed
+    // out, so a pool never goes away while a cache holds its blocks, and
+    // an empty entry may be reused for another pool
+    struct Entry {
+        SlabPool *pool;
+        Block *head;
+        std::size_t count;
+    };
+
+    struct Cache {
+        ~Cache() {
+            for (Entry &entry : entries)
+                if (entry.count > 0) entry.pool->giveBack(entry, entry.count);
+        }
+
+        std::vector<Entry> entries;
+    };
+
+    ~SlabPool() = default;
+
+    Entry &cached() {
+        thread_local Cache cache;
+        Entry *empty = nullptr;
+        for (Entry &entry : cache.entries) {
+            if (entry.pool == this) return entry;
+            if (entry.count == 0 && empty == nullptr) empty = &entry;
+        }
+        if (empty != nullptr) {
+            empty->pool = this;
+            return *empty;
+        }
+        cache.entries.push_back(Entry{this, nullptr, 0});
+        return cache.entries.back();
+    }
+
+    // moves a batch from the free list into the cache and takes one
+    // block of it, or allocates a request bigger than a block
+    void *refill(Entry &entry, std::size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (blockSize == 0) blockSize = roundUp(size);
+        if (size > blockSize) {
+            ++outstanding;
+            return ::operator new(size);
+        }
+
+        for (std::size_t i = entry.count; i < batchSize; ++i) {
+            if (freeList == nullptr) grow();
+            Block *block = freeList;
+            freeList = block->next;
+            block->next = entry.head;
+            entry.head = block;
+            ++entry.count;
+            ++outstanding;
+        }
+        Block *block = entry.head;
+        entry.head = block->next;
+        --entry.count;
+        return block;
+    }
+
+    // returns count blocks from the cache to the free list
+    void giveBack(Entry &entry, std::size_t count) {
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (std::size_t i = 0; i < count; ++i) {
+                Block *block = entry.head;
+                entry.head = block->next;
+                block->next = freeList;
+                freeList = block;
+            }
+            entry.count -= count;
+            outstanding -= count;
+            last = outstanding == 0 && retired.load(std::memory_order_relaxed);
+        }
+        if (last) delete this;
+    }
+
+    // returns one block, or a bigger allocation, straight to the pool
+    void release(void *p, std::size_t size) {
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (size > blockSize) {
+                ::operator delete(p);
+            } else {
+                Block *block = static_cast<Block *>(p);
+                block->next = freeList;
+                freeList = block;
+            }
+            --outstanding;
+            last = outstanding == 0 && retired.load(std::memory_order_relaxed);
+        }
+        if (last) delete this;
+    }
+
+    static std::size_t roundUp(std::size_t size) {
+        const std::size_t align = alignof(std::max_align_t);
+        size = size < sizeof(Block) ? sizeof(Block) : size;
+        return (size + align - 1) / align * align;
+    }
+
+    void grow() {
+        slabs.emplace_back(new std::byte[blockSize * blocksPerSlab]);
+        std::byte *slab = slabs.back().get();
+        for (std::size_t i = blocksPerSlab; i > 0; --i) {
+            Block *block = reinterpret_cast<Block *>(slab + (i - 1) * blockSize);
+            block->next = freeList;
+            freeList = block;
+        }
+    }
+
+    std::mutex mutex;
+    std::size_t blocksPerSlab;
+    std::size_t blockSize = 0;
+    std::size_t outstanding = 0;
+    std::atomic<bool> retired{false};
+    Block *freeList = nullptr;
+    std::vector<std::unique_ptr<std::byte[]>> slabs;
+};
+
+/*
+ * Pool Allocator
+ * adapts SlabPool to the allocator interface so std::allocate_shared can
+ * place both the product and its control block in one pooled block
+ */
+template <typename T>
+class PoolAllocator {
+   public:
+    using value_type = T;
+
+    explicit PoolAllocator(SlabPool *pool) : pool(pool) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &other) : pool(other.pool) {}
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(pool->allocate(n * sizeof(T)));
+    }
+    void deallocate(T *p, std::size_t n) { pool->deallocate(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &other) const {
+        return pool == other.pool;
+    }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &other) const {
+        return pool != other.pool;
+    }
+
+   private:
+    template <typename U>
+    friend class PoolAllocator;
+
+    SlabPool *pool;
+};
+
+#endif
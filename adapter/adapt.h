@@ -0,0 +1,50 @@
+#ifndef ADAPTER_ADAPT_H
+#define ADAPTER_ADAPT_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Static Adapter
+ * maps a member function of the Adaptee onto request() at compile time,
+ * so calls on a known adapter type are direct and get inlined with no
+ * vtable involved; erase() wraps the adapter in the virtual Target
+ * interface only where a type-erased boundary needs one
+ */
+template <typename Target, typename Adaptee, void (Adaptee::*Request)()>
+class Adapt {
+   public:
+    Adapt() = default;
+
+    // forwards to the Adaptee's constructor; never chosen for copies,
+    // which would otherwise match it better than the copy constructor
+    template <typename First, typename... Rest,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::decay_t<First>, Adapt>>>
+    explicit Adapt(First &&first, Rest &&... rest)
+        : adaptee(std::forward<First>(first), std::forward<Rest>(rest)...) {}
+
+    void request() { (adaptee.*Request)(); }
+    const Adaptee &get() const { return adaptee; }
+    // ...
+
+    std::unique_ptr<Target> erase() && {
+        return std::make_unique<Erased>(std::move(*this));
+    }
+
+   private:
+    class Erased final : public Target {
+       public:
+        explicit Erased(Adapt adapter) : adapter(std::move(adapter)) {}
+
+        void request() override { adapter.request(); }
+
+       private:
+        Adapt adapter;
+    };
+
+    Adaptee adaptee;
+};
+
+#endif
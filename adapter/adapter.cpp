@@ -1,5 +1,13 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "adapt.h"
 
 /*
  * Target
@@ -24,7 +32,10 @@ class Adaptee {
         std::cout << "specific request"
                   << "\n";
     }
-    // ... 
+    void specificRequests(std::size_t count) {
+        std::cout << "specific request x " << count << "\n";
+    }
+    // ...
 };
 
 /*
@@ -42,7 +53,111 @@ class Adapter : public Target, private Adaptee {
     // ...
 };
 
+// the same adaptation bound at compile time, see adapt.h
+using StaticAdapter = Adapt<Target, Adaptee, &Adaptee::specificRequest>;
+
+/*
+ * Batching Adapter
+ * collects request() calls from the Target side and forwards them to
+ * the Adaptee in one bulk call once maxBatch requests are pending or
+ * the oldest one has waited maxDelay (a zero maxDelay turns the timer
+ * off); flush() forwards whatever is pending right away and the
+ * destructor flushes before returning
+ */
+struct FlushPolicy {
+    std::size_t maxBatch = 64;
+    std::chrono::milliseconds maxDelay{0};
+};
+
+class BatchingAdapter : public Target {
+   public:
+    explicit BatchingAdapter(FlushPolicy policy = FlushPolicy{})
+        : policy(policy) {
+        if (policy.maxDelay.count() > 0)
+            timer = std::thread([this]() { wait(); });
+    }
+
+    BatchingAdapter(BatchingAdapter const &) = delete;
+    BatchingAdapter &operator=(BatchingAdapter const &) = delete;
+
+    ~BatchingAdapter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_one();
+        if (timer.joinable()) timer.join();
+        flush();
+    }
+
+    void request() override { requests(1); }
+
+    void requests(std::size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const bool first = pending == 0;
+        if (first) oldest = std::chrono::steady_clock::now();
+        pending += count;
+
+        // the timer only sleeps without a deadline while nothing is
+        // pending, so only the first request of a batch has to wake it
+        if (pending >= policy.maxBatch)
+            forward();
+        else if (first && timer.joinable())
+            wake.notify_one();
+    }
+
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex);
+        forward();
+    }
+    // ...
+
+   private:
+    // called with the mutex held, which keeps bulk calls in order
+    void forward() {
+        if (pending == 0) return;
+        adaptee.specificRequests(pending);
+        pending = 0;
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stop) {
+            if (pending == 0) {
+                wake.wait(lock, [this]() { return stop || pending > 0; });
+                continue;
+            }
+
+            auto deadline = oldest + policy.maxDelay;
+            if (std::chrono::steady_clock::now() >= deadline)
+                forward();
+            else
+                wake.wait_until(lock, deadline);
+        }
+    }
+
+    FlushPolicy policy;
+    Adaptee adaptee;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread timer;
+    std::size_t pending = 0;
+    std::chrono::steady_clock::time_point oldest;
+    bool stop = false;
+};
+
 int main() {
     std::unique_ptr<Target> t = std::make_unique<Adapter>();
     t->request();
+
+    StaticAdapter adapter;
+    adapter.request();
+
+    std::unique_ptr<Target> erased = StaticAdapter().erase();
+    erased->request();
+
+    BatchingAdapter batching(FlushPolicy{4, std::chrono::milliseconds(10)});
+    for (int i = 0; i < 6; ++i) batching.request();
+    batching.flush();
 }
\ No newline at end of file
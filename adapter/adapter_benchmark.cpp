@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "../common/do_not_optimize.h"
+#include "adapt.h"
+
+/*
+ * Benchmark of the per-call cost of request(): the virtual Adapter behind
+ * std::unique_ptr<Target>, the Adapt template called on its concrete type
+ * and the same template behind its type-erased Target wrapper; the
+ * adaptee only counts calls so the adapter overhead dominates, and every
+ * call is followed by an optimization barrier on the adapter so the
+ * inlined static loop cannot fold into a single add
+ *
+ * usage: adapter_benchmark [calls]
+ */
+class Target {
+   public:
+    virtual ~Target() = default;
+
+    virtual void request() = 0;
+};
+
+class Adaptee {
+   public:
+    void specificRequest() { ++calls; }
+
+    std::size_t calls = 0;
+};
+
+class Adapter : public Target, public Adaptee {
+   public:
+    void request() override { specificRequest(); }
+};
+
+class OtherAdapter : public Target, public Adaptee {
+   public:
+    void request() override { calls += 2; }
+};
+
+using StaticAdapter = Adapt<Target, Adaptee, &Adaptee::specificRequest>;
+
+// the concrete adapter is picked at runtime so the compiler cannot
+// devirtualize calls through the returned Target
+std::unique_ptr<Target> makeTarget(bool other) {
+    if (other) return std::make_unique<OtherAdapter>();
+    return std::make_unique<Adapter>();
+}
+
+template <typename Function>
+void measure(const char *name, std::size_t calls, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto stop = std::chrono::steady_clock::now();
+
+    std::cout << name << ": "
+              << std::chrono::duration<double, std::nano>(stop - start).count() /
+                     static_cast<double>(calls)
+              << " ns/call\n";
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t calls = argc > 1 ? std::stoul(argv[1]) : 100000000;
+    const bool other = argc > 2;
+
+    std::unique_ptr<Target> target = makeTarget(other);
+    measure("virtual Adapter", calls, [&]() {
+        for (std::size_t i = 0; i < calls; ++i) {
+            target->request();
+            doNotOptimize(*target);
+        }
+    });
+
+    StaticAdapter adapter;
+    measure("static Adapt", calls, [&]() {
+        for (std::size_t i = 0; i < calls; ++i) {
+            adapter.request();
+            doNotOptimize(adapter);
+        }
+    });
+
+    std::unique_ptr<Target> erased = other ? makeTarget(other)
+                                           : StaticAdapter().erase();
+    measure("erased Adapt", calls, [&]() {
+        for (std::size_t i = 0; i < calls; ++i) {
+            erased->request();
+            doNotOptimize(*erased);
+        }
+    });
+
+    std::cout << "static adaptee calls: " << adapter.get().calls << "\n";
+}
@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../abstractFactory/abstractFactory.h"
+#include "../builder/builder.h"
+#include "../common/do_not_optimize.h"
+#include "../prototype/prototype.h"
+#include "../singleton/singleton.h"
+
+// the factory method and builder examples both name their product
+// Product, so the factory method example goes into a namespace of its
+// own; the standard headers it includes are already included above
+namespace factoryMethod {
+#include "../factoryMethod/factoryMethod.h"
+}  // namespace factoryMethod
+
+/*
+ * Creational patterns benchmark
+ * compares the shared_ptr based paths of the creational pattern examples
+ * against the pooled, batched and value based alternatives they ship,
+ * running the classes from the pattern headers themselves; every case
+ * is measured after a warmup over several repetitions and reported as
+ * ns/op percentiles and heap allocations per op, as a table and
+ * optionally as CSV and JSON
+ *
+ * usage: bench_creational [--csv file] [--json file] [--repetitions n]
+ * with n at least 1
+ */
+
+/*
+ * Allocation counter
+ * global operator new is replaced so each case can report how many heap
+ * allocations one operation costs
+ */
+static std::atomic<std::size_t> allocations{0};
+
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+/*
+ * Harness
+ * runs a case for a number of warmup and measured repetitions; a case is
+ * a callable taking the number of operations to perform
+ */
+struct Result {
+    std::string pattern;
+    std::string variant;
+    std::size_t operations;
+    double p50;
+    double p90;
+    double p99;
+    double mean;
+    double allocationsPerOp;
+};
+
+class Harness {
+   public:
+    Harness(std::size_t warmup, std::size_t repetitions, std::size_t operations)
+        : warmup(warmup), repetitions(repetitions), operations(operations) {}
+
+    template <typename Case>
+    void run(const std::string &pattern, const std::string &variant,
+             Case function) {
+        for (std::size_t i = 0; i < warmup; ++i) function(operations);
+
+        std::vector<double> samples;
+        samples.reserve(repetitions);
+        std::size_t allocated = 0;
+        for (std::size_t i = 0; i < repetitions; ++i) {
+            std::size_t before = allocations.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            function(operations);
+            auto stop = std::chrono::steady_clock::now();
+            allocated += allocations.load(std::memory_order_relaxed) - before;
+
+            samples.push_back(
+                std::chrono::duration<double, std::nano>(stop - start).count() /
+                static_cast<double>(operations));
+        }
+
+        std::sort(samples.begin(), samples.end());
+        double sum = 0;
+        for (double sample : samples) sum += sample;
+
+        results.push_back({pattern, variant, operations, percentile(samples, 50),
+                           percentile(samples, 90), percentile(samples, 99),
+                           sum / static_cast<double>(samples.size()),
+                           static_cast<double>(allocated) /
+                               static_cast<double>(operations * repetitions)});
+        print(results.back());
+    }
+
+    void writeCsv(std::ostream &os) const {
+        os << "pattern,variant,operations,p50_ns,p90_ns,p99_ns,mean_ns,"
+              "allocations_per_op\n";
+        for (const Result &r : results)
+            os << r.pattern << "," << r.variant << "," << r.operations << ","
+               << r.p50 << "," << r.p90 << "," << r.p99 << "," << r.mean << ","
+               << r.allocationsPerOp << "\n";
+    }
+
+    void writeJson(std::ostream &os) const {
+        os << "[\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result &r = results[i];
+            os << "  {\"pattern\": \"" << r.pattern << "\", \"variant\": \""
+               << r.variant << "\", \"operations\": " << r.operations
+               << ", \"p50_ns\": " << r.p50 << ", \"p90_ns\": " << r.p90
+               << ", \"p99_ns\": " << r.p99 << ", \"mean_ns\": " << r.mean
+               << ", \"allocations_per_op\": " << r.allocationsPerOp << "}"
+               << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        os << "]\n";
+    }
+
+   private:
+    static double percentile(const std::vector<double> &sorted, int p) {
+        std::size_t rank = (sorted.size() * p + 99) / 100;
+        return sorted[rank == 0 ? 0 : rank - 1];
+    }
+
+    static void print(const Result &r) {
+        std::cout << std::left << std::setw(16) << r.pattern << std::setw(24)
+                  << r.variant << std::right << std::fixed
+                  << std::setprecision(2) << " p50 " << std::setw(8) << r.p50
+                  << " p90 " << std::setw(8) << r.p90 << " p99 " << std::setw(8)
+                  << r.p99 << " ns/op  " << r.allocationsPerOp
+                  << " allocs/op\n";
+    }
+
+    std::size_t warmup;
+    std::size_t repetitions;
+    std::size_t operations;
+    std::vector<Result> results;
+};
+
+void benchAbstractFactory(Harness &harness) {
+    harness.run("abstractFactory", "make_shared", [](std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            std::shared_ptr<AbstractProductA> product =
+                std::make_shared<ConcreteProductAX>();
+            doNotOptimize(product);
+        }
+    });
+
+    harness.run("abstractFactory", "pooled createProductA", [](std::size_t n) {
+        ConcreteFactoryX factory;
+        for (std::size_t i = 0; i < n; ++i) {
+            std::shared_ptr<AbstractProductA> product = factory.createProductA();
+            doNotOptimize(product);
+        }
+    });
+
+    harness.run("abstractFactory", "createProductsA", [](std::size_t n) {
+        ConcreteFactoryX factory;
+        ProductBlock<AbstractProductA> block = factory.createProductsA(n);
+        doNotOptimize(block);
+    });
+
+    harness.run("abstractFactory", "static Factory", [](std::size_t n) {
+        Factory<FamilyX> factory;
+        for (std::size_t i = 0; i < n; ++i) {
+            ConcreteProductAX product = factory.createProductA();
+            doNotOptimize(product);
+        }
+    });
+}
+
+void benchFactoryMethod(Harness &harness) {
+    using factoryMethod::ConcreteCreatorA;
+    using factoryMethod::ProductBatch;
+
+    harness.run("factoryMethod", "shared_ptr batch", [](std::size_t n) {
+        ConcreteCreatorA creator;
+        std::vector<std::shared_ptr<factoryMethod::Product>> batch;
+        batch.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+            batch.push_back(creator.factoryMethod());
+        doNotOptimize(batch);
+    });
+
+    harness.run("factoryMethod", "ProductBatch", [](std::size_t n) {
+        ConcreteCreatorA creator;
+        ProductBatch batch;
+        creator.factoryMethod(n, batch);
+        doNotOptimize(batch);
+    });
+}
+
+void benchBuilder(Harness &harness) {
+    harness.run("builder", "Director", [](std::size_t n) {
+        std::shared_ptr<ConcreteBuilderX> builder =
+            std::make_shared<ConcreteBuilderX>();
+        Director director;
+        director.setBuilder(builder);
+        for (std::size_t i = 0; i < n; ++i) {
+            director.constructAll();
+            std::unique_ptr<Product> product = builder->getProduct();
+            doNotOptimize(product);
+        }
+    });
+
+    ParallelDirector<ConcreteBuilderX> parallel;
+    harness.run("builder", "ParallelDirector", [&](std::size_t n) {
+        std::vector<std::unique_ptr<Product>> products =
+            parallel.construct(std::vector<Recipe>(n, Recipe::All));
+        doNotOptimize(products);
+    });
+}
+
+void benchPrototype(Harness &harness) {
+    harness.run("prototype", "shared_ptr clone", [](std::size_t n) {
+        std::shared_ptr<Prototype> prototype =
+            std::make_shared<ConcretePrototypeA>();
+        for (std::size_t i = 0; i < n; ++i) {
+            std::shared_ptr<Prototype> clone = prototype->clone();
+            doNotOptimize(clone);
+        }
+    });
+
+    harness.run("prototype", "cloneN block", [](std::size_t n) {
+        std::shared_ptr<Prototype> prototype =
+            std::make_shared<ConcretePrototypeA>();
+        CloneBlock clones = prototype->cloneN(n);
+        doNotOptimize(clones);
+    });
+
+    harness.run("prototype", "value copy", [](std::size_t n) {
+        ConcretePrototypeA prototype;
+        for (std::size_t i = 0; i < n; ++i) {
+            ConcretePrototypeA clone = prototype;
+            doNotOptimize(clone);
+        }
+    });
+
+    Client client;
+    client.init();
+    harness.run("prototype", "Client make", [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            std::shared_ptr<Prototype> clone = client.make(Type::PROTOTYPE_A);
+            doNotOptimize(clone);
+        }
+    });
+}
+
+void benchSingleton(Harness &harness) {
+    harness.run("singleton", "getInstance(string)", [](std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i)
+            doNotOptimize(&Singleton::getInstance("foo"));
+    });
+
+    harness.run("singleton", "getInstance()", [](std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i)
+            doNotOptimize(&Singleton::getInstance());
+    });
+}
+
+// parses a repetition count of at least one
+bool parseCount(const std::string &text, std::size_t &count) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos)
+        return false;
+    try {
+        count = std::stoul(text);
+    } catch (const std::out_of_range &) {
+        return false;
+    }
+    return count >= 1;
+}
+
+int main(int argc, char *argv[]) {
+    std::string csv;
+    std::string json;
+    std::size_t repetitions = 30;
+
+    for (int i = 1; i < argc; i += 2) {
+        std::string option = argv[i];
+        bool valid = i + 1 < argc;
+        if (valid && option == "--csv")
+            csv = argv[i + 1];
+        else if (valid && option == "--json")
+            json = argv[i + 1];
+        else if (valid && option == "--repetitions")
+            valid = parseCount(argv[i + 1], repetitions);
+        else
+            valid = false;
+
+        if (!valid) {
+            std::cerr << "usage: " << argv[0]
+                      << " [--csv file] [--json file] [--repetitions n]\n"
+                         "n must be a whole number of at least 1\n";
+            return 1;
+        }
+    }
+
+    Harness harness(3, repetitions, 100000);
+    benchAbstractFactory(harness);
+    benchFactoryMethod(harness);
+    benchBuilder(harness);
+    benchPrototype(harness);
+    benchSingleton(harness);
+
+    if (!csv.empty()) {
+        std::ofstream file(csv);
+        harness.writeCsv(file);
+    }
+    if (!json.empty()) {
+        std::ofstream file(json);
+        harness.writeJson(file);
+    }
+}
@@ -1,67 +1,8 @@
 #include <iostream>
 #include <memory>
+#include <vector>
 
-/*
- * Implementor
- * defines the interface for implementation classes
- */
-class Implementor {
-   public:
-    virtual ~Implementor() = default;
-
-    virtual std::string operationImpl() const = 0;
-    // ...
-};
-
-/*
- * Concrete Implementors
- * implement the Implementor interface and define concrete implementations
- */
-class ConcreteImplA : public Implementor {
-   public:
-    std::string operationImpl() const override { return "ConcreteImplA"; }
-    // ...
-};
-
-class ConcreteImplB : public Implementor {
-   public:
-    std::string operationImpl() const override { return "ConcreteImplB"; }
-    // ...
-};
-
-/*
- * Abstraction
- * defines the abstraction's interface
- */
-class Abstraction {
-   public:
-    Abstraction(std::shared_ptr<Implementor> implementor)
-        : implementor(implementor) {}
-
-    virtual ~Abstraction() = default;
-
-    virtual std::string operation() const = 0;
-    // ...
-
-   protected:
-    std::shared_ptr<Implementor> implementor;
-};
-
-/*
- * RefinedAbstraction
- * extends the interface defined by Abstraction
- */
-class RefinedAbstraction : public Abstraction {
-   public:
-    RefinedAbstraction(std::shared_ptr<Implementor> implementor)
-        : Abstraction(implementor) {}
-
-    std::string operation() const override {
-        return "RefinedAbstraction: refined operation with " +
-               implementor->operationImpl();
-    }
-    // ...
-};
+#include "bridge.h"
 
 int main() {
     std::shared_ptr<Implementor> implementor =
@@ -70,4 +11,20 @@ int main() {
         std::make_shared<RefinedAbstraction>(implementor);
 
     std::cout << abstraction->operation();
+
+    Sink sink;
+    abstraction->operation(sink);
+    std::cout << "\n" << sink.view();
+
+    auto hotSwap = std::make_shared<HotSwapImplementor>(implementor);
+    RefinedAbstraction swappable(hotSwap);
+    hotSwap->swap(std::make_shared<ConcreteImplB>());
+    sink.clear();
+    swappable.operation(sink);
+    std::cout << "\n" << sink.view();
+
+    RefinedAbstraction refined(selectImplementor());
+    std::vector<float> buffer(1000, 0.5f);
+    std::cout << "\n" << refined.operation() << " sums to "
+              << refined.sum(buffer.data(), buffer.size()) << "\n";
 }
\ No newline at end of file
@@ -0,0 +1,284 @@
+#ifndef BRIDGE_BRIDGE_H
+#define BRIDGE_BRIDGE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// the x86 kernels rely on GCC/Clang target attributes and cpu builtins
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BRIDGE_X86 1
+#endif
+
+#include "rcu.h"
+
+/*
+ * Sink
+ * caller owned buffer that operations append their output to; clear()
+ * keeps the capacity, so once the buffer has grown writes no longer
+ * allocate
+ */
+class Sink {
+   public:
+    void append(std::string_view text) { buffer.append(text); }
+    void clear() { buffer.clear(); }
+    std::string_view view() const { return buffer; }
+
+   private:
+    std::string buffer;
+};
+
+/*
+ * Implementor
+ * defines the interface for implementation classes; operationImpl(Sink&)
+ * streams the result instead of returning a new string, and sum() is a
+ * buffer kernel with a scalar default that SIMD implementors override
+ */
+class Implementor {
+   public:
+    virtual ~Implementor() = default;
+
+    virtual std::string operationImpl() const = 0;
+    virtual void operationImpl(Sink &sink) const = 0;
+
+    virtual float sum(const float *data, std::size_t size) const {
+        float result = 0;
+        for (std::size_t i = 0; i < size; ++i) result += data[i];
+        return result;
+    }
+    // ...
+};
+
+/*
+ * Concrete Implementors
+ * implement the Implementor interface and define concrete implementations
+ */
+class ConcreteImplA : public Implementor {
+   public:
+    std::string operationImpl() const override { return "ConcreteImplA"; }
+    void operationImpl(Sink &sink) const override {
+        sink.append("ConcreteImplA");
+    }
+    // ...
+};
+
+class ConcreteImplB : public Implementor {
+   public:
+    std::string operationImpl() const override { return "ConcreteImplB"; }
+    void operationImpl(Sink &sink) const override {
+        sink.append("ConcreteImplB");
+    }
+    // ...
+};
+
+/*
+ * SIMD Implementors
+ * run the sum() kernel with SSE4.2, AVX2 or AVX-512 instructions; each
+ * kernel is compiled for its instruction set through a target attribute,
+ * so the binary runs anywhere and selectImplementor() picks the best one
+ * the CPU supports at startup
+ */
+class ScalarImpl : public Implementor {
+   public:
+    std::string operationImpl() const override { return "ScalarImpl"; }
+    void operationImpl(Sink &sink) const override {
+        sink.append("ScalarImpl");
+    }
+};
+
+#ifdef BRIDGE_X86
+class SseImpl : public Implementor {
+   public:
+    std::string operationImpl() const override { return "SseImpl"; }
+    void operationImpl(Sink &sink) const override {
+        sink.append("SseImpl");
+    }
+
+    __attribute__((target("sse"))) float sum(
+        const float *data, std::size_t size) const override {
+        __m128 acc = _mm_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            acc = _mm_add_ps(acc, _mm_loadu_ps(data + i));
+
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, acc);
+        float result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        for (; i < size; ++i) result += data[i];
+        return result;
+    }
+};
+
+class Avx2Impl : public Implementor {
+   public:
+    std::string operationImpl() const override { return "Avx2Impl"; }
+    void operationImpl(Sink &sink) const override {
+        sink.append("Avx2Impl");
+    }
+
+    __attribute__((target("avx2"))) float sum(
+        const float *data, std::size_t size) const override {
+        __m256 acc = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+            acc = _mm256_add_ps(acc, _mm256_loadu_ps(data + i));
+
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, acc);
+        float result = 0;
+        for (float lane : lanes) result += lane;
+        for (; i < size; ++i) result += data[i];
+        return result;
+    }
+};
+
+class Avx512Impl : public Implementor {
+   public:
+    std::string operationImpl() const override { return "Avx512Impl"; }
+    void operationImpl(Sink &sink) const override {
+        sink.append("Avx512Impl");
+    }
+
+    __attribute__((target("avx512f"))) float sum(
+        const float *data, std::size_t size) const override {
+        __m512 acc = _mm512_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+            acc = _mm512_add_ps(acc, _mm512_loadu_ps(data + i));
+
+        float result = _mm512_reduce_add_ps(acc);
+        for (; i < size; ++i) result += data[i];
+        return result;
+    }
+};
+#endif
+
+/*
+ * Implementor selection
+ * picks the widest kernel the CPU supports, once per process; the
+ * BRIDGE_IMPL environment variable (scalar, sse, avx2 or avx512)
+ * overrides the choice so every path can be measured on one host, and
+ * an override that cannot be honored is reported on stderr
+ */
+inline std::shared_ptr<Implementor> createImplementor(
+    const std::string &name) {
+#ifdef BRIDGE_X86
+    __builtin_cpu_init();
+    if (name == "avx512" && __builtin_cpu_supports("avx512f"))
+        return std::make_shared<Avx512Impl>();
+    if (name == "avx2" && __builtin_cpu_supports("avx2"))
+        return std::make_shared<Avx2Impl>();
+    if (name == "sse" && __builtin_cpu_supports("sse"))
+        return std::make_shared<SseImpl>();
+#endif
+    if (name == "scalar") return std::make_shared<ScalarImpl>();
+    return nullptr;
+}
+
+inline std::shared_ptr<Implementor> selectImplementor() {
+    static const std::shared_ptr<Implementor> selected = []() {
+        std::shared_ptr<Implementor> implementor;
+        if (const char *name = std::getenv("BRIDGE_IMPL")) {
+            if ((implementor = createImplementor(name))) return implementor;
+            std::cerr << "BRIDGE_IMPL=" << name
+                      << " is unknown or not supported by this CPU, "
+                         "selecting an implementor automatically\n";
+        }
+
+        for (const char *name : {"avx512", "avx2", "sse"})
+            if ((implementor = createImplementor(name))) return implementor;
+        return createImplementor("scalar");
+    }();
+    return selected;
+}
+
+/*
+ * Hot Swap Implementor
+ * forwards to an implementor that can be replaced under live traffic;
+ * readers load a raw pointer inside an Rcu read section, with no lock
+ * and no refcount increment, and swap() frees the previous implementor
+ * only after every call that could still use it has returned
+ */
+class HotSwapImplementor : public Implementor {
+   public:
+    explicit HotSwapImplementor(std::shared_ptr<Implementor> implementor)
+        : owner(std::move(implementor)), current(owner.get()) {}
+
+    void swap(std::shared_ptr<Implementor> implementor) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<Implementor> retired = std::move(owner);
+        owner = std::move(implementor);
+        current.store(owner.get());
+        Rcu::getInstance().synchronize();
+    }
+
+    std::string operationImpl() const override {
+        Rcu::ReadGuard guard;
+        return current.load()->operationImpl();
+    }
+    void operationImpl(Sink &sink) const override {
+        Rcu::ReadGuard guard;
+        current.load()->operationImpl(sink);
+    }
+    float sum(const float *data, std::size_t size) const override {
+        Rcu::ReadGuard guard;
+        return current.load()->sum(data, size);
+    }
+
+   private:
+    std::mutex mutex;
+    std::shared_ptr<Implementor> owner;
+    std::atomic<Implementor *> current;
+};
+
+/*
+ * Abstraction
+ * defines the abstraction's interface
+ */
+class Abstraction {
+   public:
+    Abstraction(std::shared_ptr<Implementor> implementor)
+        : implementor(implementor) {}
+
+    virtual ~Abstraction() = default;
+
+    virtual std::string operation() const = 0;
+    virtual void operation(Sink &sink) const = 0;
+    // ...
+
+   protected:
+    std::shared_ptr<Implementor> implementor;
+};
+
+/*
+ * RefinedAbstraction
+ * extends the interface defined by Abstraction
+ */
+class RefinedAbstraction : public Abstraction {
+   public:
+    RefinedAbstraction(std::shared_ptr<Implementor> implementor)
+        : Abstraction(implementor) {}
+
+    std::string operation() const override {
+        return "RefinedAbstraction: refined operation with " +
+               implementor->operationImpl();
+    }
+    void operation(Sink &sink) const override {
+        sink.append("RefinedAbstraction: refined operation with ");
+        implementor->operationImpl(sink);
+    }
+
+    float sum(const float *data, std::size_t size) const {
+        return implementor->sum(data, size);
+    }
+    // ...
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "bridge.h"
+
+/*
+ * Benchmark of RefinedAbstraction::operation(): the string returning
+ * path against the Sink path, reporting ns and heap allocations per call;
+ * allocations are counted through a replaced global operator new and the
+ * sink is warmed up once, so steady state should show zero
+ *
+ * usage: bridge_benchmark [calls]
+ */
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t size) {
+    ++allocations;
+    if (void *p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+template <typename Function>
+void measure(const char *name, std::size_t calls, Function function) {
+    std::size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    std::size_t checksum = function();
+    auto stop = std::chrono::steady_clock::now();
+
+    std::cout << name << ": "
+              << std::chrono::duration<double, std::nano>(stop - start).count() /
+                     static_cast<double>(calls)
+              << " ns/call, "
+              << static_cast<double>(allocations - before) /
+                     static_cast<double>(calls)
+              << " allocations/call (checksum " << checksum << ")\n";
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t calls = argc > 1 ? std::stoul(argv[1]) : 10000000;
+    std::shared_ptr<Abstraction> abstraction =
+        std::make_shared<RefinedAbstraction>(std::make_shared<ConcreteImplA>());
+
+    measure("operation()", calls, [&]() {
+        std::size_t checksum = 0;
+        for (std::size_t i = 0; i < calls; ++i)
+            checksum += abstraction->operation().size();
+        return checksum;
+    });
+
+    Sink sink;
+    abstraction->operation(sink);
+    measure("operation(Sink&)", calls, [&]() {
+        std::size_t checksum = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            sink.clear();
+            abstraction->operation(sink);
+            checksum += sink.view().size();
+        }
+        return checksum;
+    });
+}
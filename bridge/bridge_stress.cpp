@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bridge.h"
+
+/*
+ * Stress test of HotSwapImplementor: reader threads call operationImpl()
+ * in a loop while a writer swaps the implementor every millisecond;
+ * reports reader cost per call next to a plain shared_ptr implementor
+ * and std::atomic_load of a shared_ptr, the swap latency, and fails if
+ * a reader ever sees anything but a live implementor
+ *
+ * usage: bridge_stress [readers] [milliseconds]
+ */
+
+// writes "freed" once destroyed, so a reader that outlives the
+// implementor it loaded is caught
+class CheckedImplB : public Implementor {
+   public:
+    ~CheckedImplB() override { alive = false; }
+
+    std::string operationImpl() const override { return "ConcreteImplB"; }
+    void operationImpl(Sink &sink) const override {
+        sink.append(alive ? "ConcreteImplB" : "freed");
+    }
+
+   private:
+    volatile bool alive = true;
+};
+
+template <typename Read>
+double readers(std::size_t threads, std::chrono::milliseconds duration,
+               std::atomic<bool> &failed, Read read) {
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> calls{0};
+    std::vector<std::thread> workers;
+
+    for (std::size_t t = 0; t < threads; ++t)
+        workers.emplace_back([&]() {
+            Sink sink;
+            std::size_t count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                sink.clear();
+                read(sink);
+                if (sink.view() != "ConcreteImplA" &&
+                    sink.view() != "ConcreteImplB")
+                    failed = true;
+                ++count;
+            }
+            calls += count;
+        });
+
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for (std::thread &worker : workers) worker.join();
+
+    return std::chrono::duration<double, std::nano>(duration).count() *
+           static_cast<double>(threads) / static_cast<double>(calls.load());
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t threads =
+        argc > 1 ? std::stoul(argv[1])
+                 : std::max(1u, std::thread::hardware_concurrency());
+    const std::chrono::milliseconds duration(argc > 2 ? std::stoul(argv[2])
+                                                      : 1000);
+    std::atomic<bool> failed{false};
+
+    std::shared_ptr<Implementor> plain = std::make_shared<ConcreteImplA>();
+    std::cout << "plain shared_ptr: "
+              << readers(threads, duration, failed,
+                         [&](Sink &sink) { plain->operationImpl(sink); })
+              << " ns/call\n";
+
+    std::shared_ptr<Implementor> shared = std::make_shared<ConcreteImplA>();
+    std::cout << "atomic_load shared_ptr: "
+              << readers(threads, duration, failed,
+                         [&](Sink &sink) {
+                             std::atomic_load(&shared)->operationImpl(sink);
+                         })
+              << " ns/call\n";
+
+    HotSwapImplementor hotSwap(std::make_shared<ConcreteImplA>());
+    std::atomic<bool> stop{false};
+    std::vector<double> latencies;
+    std::thread writer([&]() {
+        for (std::size_t i = 0; !stop; ++i) {
+            std::shared_ptr<Implementor> next;
+            if (i % 2 == 0)
+                next = std::make_shared<CheckedImplB>();
+            else
+                next = std::make_shared<ConcreteImplA>();
+
+            auto start = std::chrono::steady_clock::now();
+            hotSwap.swap(std::move(next));
+            auto end = std::chrono::steady_clock::now();
+            latencies.push_back(
+                std::chrono::duration<double, std::micro>(end - start).count());
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    double rcu = readers(threads, duration, failed,
+                         [&](Sink &sink) { hotSwap.operationImpl(sink); });
+    stop = true;
+    writer.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "hot swap: " << rcu << " ns/call, " << latencies.size()
+              << " swaps, swap latency p50 " << latencies[latencies.size() / 2]
+              << " us, max " << latencies.back() << " us\n";
+
+    if (failed) {
+        std::cout << "FAILED: a reader saw a freed implementor\n";
+        return 1;
+    }
+}
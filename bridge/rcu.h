@@ -0,0 +1,98 @@
+#ifndef BRIDGE_RCU_H
+#define BRIDGE_RCU_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+/*
+ * Read-Copy-Update domain
+ * every reading thread owns a cache-line sized record where it announces
+ * the epoch it started reading in; readers only store to their own
+ * record, and synchronize() waits until no reader that started before
+ * the current epoch is still inside a read section
+ */
+class Rcu {
+    struct Reader;
+
+   public:
+    Rcu(Rcu const &) = delete;
+    Rcu &operator=(Rcu const &) = delete;
+
+    static Rcu &getInstance() {
+        static Rcu instance;
+        return instance;
+    }
+
+    class ReadGuard {
+       public:
+        ReadGuard() : reader(Rcu::getInstance().local()) {
+            if (reader.depth++ == 0)
+                reader.record->epoch.store(Rcu::getInstance().epoch.load());
+        }
+        ~ReadGuard() {
+            if (--reader.depth == 0)
+                reader.record->epoch.store(0, std::memory_order_release);
+        }
+
+        ReadGuard(ReadGuard const &) = delete;
+        ReadGuard &operator=(ReadGuard const &) = delete;
+
+       private:
+        Reader &reader;
+    };
+
+    void synchronize() {
+        const std::uint64_t current = epoch.fetch_add(1) + 1;
+        for (Record *record = records.load(); record; record = record->next)
+            for (;;) {
+                std::uint64_t seen = record->epoch.load();
+                if (seen == 0 || seen >= current) break;
+                std::this_thread::yield();
+            }
+    }
+
+   private:
+    struct alignas(64) Record {
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> used{true};
+        Record *next = nullptr;
+    };
+
+    struct Reader {
+        Record *record;
+        std::size_t depth = 0;
+
+        ~Reader() { record->used.store(false, std::memory_order_release); }
+    };
+
+    Rcu() = default;
+
+    // records are never freed; a thread that exits hands its record
+    // over to the next thread that starts reading
+    Reader &local() {
+        thread_local Reader reader{acquire()};
+        return reader;
+    }
+
+    Record *acquire() {
+        for (Record *record = records.load(); record; record = record->next) {
+            bool used = false;
+            if (!record->used.load(std::memory_order_relaxed) &&
+                record->used.compare_exchange_strong(used, true))
+                return record;
+        }
+
+        Record *record = new Record;
+        record->next = records.load();
+        while (!records.compare_exchange_weak(record->next, record)) {
+        }
+        return record;
+    }
+
+    std::atomic<std::uint64_t> epoch{1};
+    std::atomic<Record *> records{nullptr};
+};
+
+#endif
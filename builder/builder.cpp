@@ -1,133 +1,104 @@
+#include <array>
+#include <cstddef>
 #include <iostream>
 #include <memory>
-#include <sstream>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "builder.h"
+
 /*
- * Product
- * the final object that will be created using Builder
+ * Fixed Product
+ * product whose parts live in inline storage sized at compile time,
+ * so it never touches the heap and can be built in constant expressions
  */
-class Product {
+template <std::size_t Capacity>
+class FixedProduct {
    public:
-    void addPart(std::string part) { parts.push_back(part); }
-
-    std::string operator()() const {
-        std::ostringstream oss;
+    constexpr void addPart(std::string_view part) { parts[count++] = part; }
 
-        for (auto i : parts)
-            if (i == parts.back())
-                oss << i;
-            else
-                oss << i << " ";
-        oss << "\n";
+    constexpr std::size_t size() const { return count; }
+    constexpr std::string_view operator[](std::size_t i) const {
+        return parts[i];
+    }
 
-        return oss.str();
+    template <typename String>
+    void render(String &out) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i != 0) out += ' ';
+            out += parts[i];
+        }
+        out += '\n';
     }
-    // ...
 
    private:
-    std::vector<std::string> parts;
+    std::array<std::string_view, Capacity> parts{};
+    std::size_t count = 0;
 };
 
 /*
- * Builder
- * abstract interface for creating products
+ * Typestate Builder
+ * encodes in its type which parts have been built: building a part
+ * twice or asking for the product before every Required part is built
+ * fails to compile; Parts supplies the family's part names
  */
-class Builder {
-   public:
-    virtual ~Builder() = default;
+enum Part : unsigned { PartA = 1u << 0, PartB = 1u << 1, PartC = 1u << 2 };
 
-    virtual void buildPartA() const = 0;
-    virtual void buildPartB() const = 0;
-    virtual void buildPartC() const = 0;
-    //...
+struct PartsX {
+    static constexpr std::string_view partA = "AX";
+    static constexpr std::string_view partB = "BX";
+    static constexpr std::string_view partC = "CX";
 };
 
-/*
- * Concrete Builder X and Y
- * create real products and stores them in the composite structure
- */
-class ConcreteBuilderX : public Builder {
-   public:
-    ConcreteBuilderX() { this->reset(); }
-
-    void reset() { product = std::make_unique<Product>(); }
-    void buildPartA() const override { product->addPart("AX"); }
-    void buildPartB() const override { product->addPart("BX"); }
-    void buildPartC() const override { product->addPart("CX"); }
-
-    /**
-     * Concrete Builders are supposed to provide their own methods for
-     * retrieving results. That's because various types of builders may create
-     * entirely different products that don't follow the same interface.
-     * Therefore, such methods cannot be declared in the base Builder interface
-     * (at least in a statically typed programming language).
-     */
-    std::unique_ptr<Product> getProduct() {
-        std::unique_ptr<Product> result = std::move(product);
-        this->reset();
-        return std::move(result);
-    }
-    //...
-
-   private:
-    std::unique_ptr<Product> product;
+struct PartsY {
+    static constexpr std::string_view partA = "AY";
+    static constexpr std::string_view partB = "BY";
+    static constexpr std::string_view partC = "CY";
 };
 
-class ConcreteBuilderY : public Builder {
+template <typename Parts, unsigned Required, unsigned Built = 0>
+class TypestateBuilder {
    public:
-    ConcreteBuilderY() { this->reset(); }
-
-    void reset() { product = std::make_unique<Product>(); }
-    void buildPartA() const override { product->addPart("AY"); }
-    void buildPartB() const override { product->addPart("BY"); }
-    void buildPartC() const override { product->addPart("CY"); }
-
-    /**
-     * Concrete Builders are supposed to provide their own methods for
-     * retrieving results. That's because various types of builders may create
-     * entirely different products that don't follow the same interface.
-     * Therefore, such methods cannot be declared in the base Builder interface
-     * (at least in a statically typed programming language).
-     */
-    std::unique_ptr<Product> getProduct() {
-        std::unique_ptr<Product> result = std::move(product);
-        this->reset();
-        return std::move(result);
-    }
-    //...
+    using Product = FixedProduct<3>;
 
-   private:
-    std::unique_ptr<Product> product;
-};
+    constexpr TypestateBuilder() = default;
 
-/*
- * Director
- * responsible for managing the correct sequence of object creation
- */
-class Director {
-   public:
-    void setBuilder(std::shared_ptr<Builder> builder) {
-        this->builder = builder;
+    constexpr auto buildPartA() const {
+        static_assert((Built & PartA) == 0, "part A is already built");
+        return next<PartA>(Parts::partA);
     }
-
-    void constructA() { builder->buildPartA(); }
-    void constructAll() {
-        builder->buildPartA();
-        builder->buildPartB();
-        builder->buildPartC();
+    constexpr auto buildPartB() const {
+        static_assert((Built & PartB) == 0, "part B is already built");
+        return next<PartB>(Parts::partB);
     }
-
-    std::shared_ptr<ConcreteBuilderX> getConcreteBuilderX() {
-        return std::static_pointer_cast<ConcreteBuilderX>(builder);
+    constexpr auto buildPartC() const {
+        static_assert((Built & PartC) == 0, "part C is already built");
+        return next<PartC>(Parts::partC);
     }
-    std::shared_ptr<ConcreteBuilderY> getConcreteBuilderY() {
-        return std::static_pointer_cast<ConcreteBuilderY>(builder);
+
+    constexpr Product getProduct() const {
+        static_assert((Built & Required) == Required,
+                      "a required part has not been built");
+        return product;
     }
-    // ...
 
    private:
-    std::shared_ptr<Builder> builder;
+    template <typename, unsigned, unsigned>
+    friend class TypestateBuilder;
+
+    constexpr explicit TypestateBuilder(const Product &product)
+        : product(product) {}
+
+    template <unsigned Part>
+    constexpr TypestateBuilder<Parts, Required, Built | Part> next(
+        std::string_view part) const {
+        Product result = product;
+        result.addPart(part);
+        return TypestateBuilder<Parts, Required, Built | Part>(result);
+    }
+
+    Product product;
 };
 
 int main() {
@@ -147,4 +118,20 @@ int main() {
 
     std::unique_ptr<Product> product2 = std::static_pointer_cast<ConcreteBuilderY>(builder)->getProduct();
     std::cout << "2nd product parts: " << (*product2)();
+
+    ParallelDirector<ConcreteBuilderX> parallelDirector;
+    std::vector<std::unique_ptr<Product>> products =
+        parallelDirector.construct({Recipe::All, Recipe::A, Recipe::All});
+    for (const std::unique_ptr<Product> &product : products)
+        std::cout << "Batch product parts: " << (*product)();
+
+    constexpr FixedProduct<3> product3 = TypestateBuilder<PartsY, PartA | PartC>()
+                                             .buildPartA()
+                                             .buildPartC()
+                                             .getProduct();
+    static_assert(product3.size() == 2, "product is built at compile time");
+
+    std::string parts;
+    product3.render(parts);
+    std::cout << "3rd product parts: " << parts;
 }
\ No newline at end of file
@@ -0,0 +1,344 @@
+#ifndef BUILDER_BUILDER_H
+#define BUILDER_BUILDER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../common/work_stealing_pool.h"
+
+/*
+ * Arena
+ * monotonic memory that holds everything one product allocates; the
+ * inline buffer fits a product of a few short parts, like the ones the
+ * builders below make, and bigger products spill to the heap
+ */
+struct Arena {
+    static constexpr std::size_t inlineSize = 256;
+
+    Arena() : resource(buffer, sizeof(buffer)) {}
+
+    Arena(Arena const &) = delete;
+    Arena &operator=(Arena const &) = delete;
+
+    alignas(std::max_align_t) std::byte buffer[inlineSize];
+    std::pmr::monotonic_buffer_resource resource;
+};
+
+/*
+ * Arena Pool
+ * keeps released arenas for reuse, so a builder starting a new product
+ * takes a ready arena instead of allocating one; every thread has its
+ * own free list and only moves arenas to and from the shared list in
+ * batches of half a local list, so the shared lock is taken once per
+ * batch instead of once per product; arenas beyond the limits are
+ * freed instead of kept
+ */
+class ArenaPool {
+   public:
+    static constexpr std::size_t localLimit = 256;
+    static constexpr std::size_t sharedLimit = 4096;
+
+    struct Recycle {
+        void operator()(Arena *arena) const {
+            ArenaPool::getInstance().recycle(arena);
+        }
+    };
+    using Handle = std::unique_ptr<Arena, Recycle>;
+
+    ArenaPool(ArenaPool const &) = delete;
+    ArenaPool &operator=(ArenaPool const &) = delete;
+
+    static ArenaPool &getInstance() {
+        static ArenaPool instance;
+        return instance;
+    }
+
+    Handle acquire() {
+        std::vector<std::unique_ptr<Arena>> &arenas = local().arenas;
+        if (arenas.empty()) take(arenas, localLimit / 2);
+        if (arenas.empty()) return Handle(new Arena);
+
+        Arena *arena = arenas.back().release();
+        arenas.pop_back();
+        return Handle(arena);
+    }
+
+    void recycle(Arena *arena) {
+        arena->resource.release();
+        std::vector<std::unique_ptr<Arena>> &arenas = local().arenas;
+        if (arenas.size() == localLimit) give(arenas, localLimit / 2);
+        arenas.emplace_back(arena);
+    }
+
+   private:
+    // a thread that exits hands its arenas to the shared list
+    struct Cache {
+        ~Cache() { ArenaPool::getInstance().give(arenas, arenas.size()); }
+
+        std::vector<std::unique_ptr<Arena>> arenas;
+    };
+
+    ArenaPool() = default;
+
+    static Cache &local() {
+        thread_local Cache cache;
+        return cache;
+    }
+
+    // moves up to count arenas from the shared list to arenas
+    void take(std::vector<std::unique_ptr<Arena>> &arenas, std::size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (; count > 0 && !shared.empty(); --count) {
+            arenas.push_back(std::move(shared.back()));
+            shared.pop_back();
+        }
+    }
+
+    // moves count arenas from the back of arenas to the shared list and
+    // frees the ones that do not fit
+    void give(std::vector<std::unique_ptr<Arena>> &arenas, std::size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (; count > 0; --count) {
+            if (shared.size() < sharedLimit)
+                shared.push_back(std::move(arenas.back()));
+            arenas.pop_back();
+        }
+    }
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Arena>> shared;
+};
+
+/*
+ * Product
+ * the final object that will be created using Builder; parts are copied
+ * into the product's arena and kept as views into it, the rendered
+ * parts are cached until the next addPart, and render() appends them
+ * to a caller supplied buffer after sizing it once
+ *
+ * the arena only grows while the product lives: memory the parts list
+ * or the cached render leave behind when they grow is not reused until
+ * the product is destroyed; both grow geometrically, so a product that
+ * alternates addPart() and operator()() holds at most a small constant
+ * factor more than its final size
+ */
+class Product {
+   public:
+    explicit Product(ArenaPool::Handle arena)
+        : arena(std::move(arena)),
+          parts(&this->arena->resource),
+          rendered(&this->arena->resource) {}
+
+    void addPart(std::string_view part) {
+        char *data =
+            static_cast<char *>(arena->resource.allocate(part.size(), 1));
+        std::copy(part.begin(), part.end(), data);
+        parts.emplace_back(data, part.size());
+        cached = false;
+    }
+
+    std::string_view operator()() const {
+        if (!cached) {
+            rendered.clear();
+            if (rendered.capacity() < size())
+                rendered.reserve(std::max(size(), 2 * rendered.capacity()));
+            render(rendered);
+            cached = true;
+        }
+        return rendered;
+    }
+
+    template <typename String>
+    void render(String &out) const {
+        out.reserve(out.size() + size());
+
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            if (i != 0) out += ' ';
+            out += parts[i];
+        }
+        out += '\n';
+    }
+    // ...
+
+   private:
+    // length of the rendered parts, separators and newline included
+    std::size_t size() const {
+        std::size_t size = parts.empty() ? 1 : parts.size();
+        for (std::string_view part : parts) size += part.size();
+        return size;
+    }
+
+    ArenaPool::Handle arena;
+    std::pmr::vector<std::string_view> parts;
+    mutable std::pmr::string rendered;
+    mutable bool cached = false;
+};
+
+/*
+ * Builder
+ * abstract interface for creating products
+ */
+class Builder {
+   public:
+    virtual ~Builder() = default;
+
+    virtual void buildPartA() const = 0;
+    virtual void buildPartB() const = 0;
+    virtual void buildPartC() const = 0;
+    //...
+};
+
+/*
+ * Concrete Builder X and Y
+ * create real products and stores them in the composite structure;
+ * getProduct() hands the product off together with its arena and
+ * reset() starts the next one on an arena recycled from the pool
+ */
+class ConcreteBuilderX : public Builder {
+   public:
+    ConcreteBuilderX() { this->reset(); }
+
+    void reset() {
+        product = std::make_unique<Product>(ArenaPool::getInstance().acquire());
+    }
+    void buildPartA() const override { product->addPart("AX"); }
+    void buildPartB() const override { product->addPart("BX"); }
+    void buildPartC() const override { product->addPart("CX"); }
+
+    /**
+     * Concrete Builders are supposed to provide their own methods for
+     * retrieving results. That's because various types of builders may create
+     * entirely different products that don't follow the same interface.
+     * Therefore, such methods cannot be declared in the base Builder interface
+     * (at least in a statically typed programming language).
+     */
+    std::unique_ptr<Product> getProduct() {
+        std::unique_ptr<Product> result = std::move(product);
+        this->reset();
+        return result;
+    }
+    //...
+
+   private:
+    std::unique_ptr<Product> product;
+};
+
+class ConcreteBuilderY : public Builder {
+   public:
+    ConcreteBuilderY() { this->reset(); }
+
+    void reset() {
+        product = std::make_unique<Product>(ArenaPool::getInstance().acquire());
+    }
+    void buildPartA() const override { product->addPart("AY"); }
+    void buildPartB() const override { product->addPart("BY"); }
+    void buildPartC() const override { product->addPart("CY"); }
+
+    /**
+     * Concrete Builders are supposed to provide their own methods for
+     * retrieving results. That's because various types of builders may create
+     * entirely different products that don't follow the same interface.
+     * Therefore, such methods cannot be declared in the base Builder interface
+     * (at least in a statically typed programming language).
+     */
+    std::unique_ptr<Product> getProduct() {
+        std::unique_ptr<Product> result = std::move(product);
+        this->reset();
+        return result;
+    }
+    //...
+
+   private:
+    std::unique_ptr<Product> product;
+};
+
+/*
+ * Director
+ * responsible for managing the correct sequence of object creation
+ */
+class Director {
+   public:
+    void setBuilder(std::shared_ptr<Builder> builder) {
+        this->builder = builder;
+    }
+
+    void constructA() { builder->buildPartA(); }
+    void constructAll() {
+        builder->buildPartA();
+        builder->buildPartB();
+        builder->buildPartC();
+    }
+
+    std::shared_ptr<ConcreteBuilderX> getConcreteBuilderX() {
+        return std::static_pointer_cast<ConcreteBuilderX>(builder);
+    }
+    std::shared_ptr<ConcreteBuilderY> getConcreteBuilderY() {
+        return std::static_pointer_cast<ConcreteBuilderY>(builder);
+    }
+    // ...
+
+   private:
+    std::shared_ptr<Builder> builder;
+};
+
+/*
+ * Parallel Director
+ * constructs a batch of products from recipes on a work stealing pool;
+ * every worker drives its own builder through its own Director and the
+ * products are returned in recipe order; there is one worker per
+ * hardware thread unless a count is given; workers take arenas from
+ * their own ArenaPool free lists, so the per-product path shares no lock
+ */
+enum class Recipe { A, All };
+
+template <typename ConcreteBuilder>
+class ParallelDirector {
+   public:
+    explicit ParallelDirector(
+        std::size_t workers = std::max(1u, std::thread::hardware_concurrency()),
+        std::size_t chunkSize = 256)
+        : chunkSize(chunkSize), pool(workers) {
+        for (std::size_t i = 0; i < pool.size(); ++i) {
+            builders.push_back(std::make_shared<ConcreteBuilder>());
+            directors.emplace_back();
+            directors.back().setBuilder(builders.back());
+        }
+    }
+
+    std::vector<std::unique_ptr<Product>> construct(
+        const std::vector<Recipe> &recipes) {
+        std::vector<std::unique_ptr<Product>> products(recipes.size());
+        const std::size_t chunks = (recipes.size() + chunkSize - 1) / chunkSize;
+
+        pool.run(chunks, [&](std::size_t worker, std::size_t chunk) {
+            Director &director = directors[worker];
+            ConcreteBuilder &builder = *builders[worker];
+            const std::size_t end =
+                std::min(recipes.size(), (chunk + 1) * chunkSize);
+
+            for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+                if (recipes[i] == Recipe::A)
+                    director.constructA();
+                else
+                    director.constructAll();
+                products[i] = builder.getProduct();
+            }
+        });
+        return products;
+    }
+
+   private:
+    std::size_t chunkSize;
+    WorkStealingPool pool;
+    std::vector<std::shared_ptr<ConcreteBuilder>> builders;
+    std::vector<Director> directors;
+};
+
+#endif
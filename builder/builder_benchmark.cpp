@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "builder.h"
+
+/*
+ * Benchmark of ParallelDirector: builds the same batch of recipes with the
+ * serial Director and with parallel directors of growing worker counts
+ * and reports products per second and speedup over the serial run; on a
+ * single hardware thread only the one worker run happens, so the output
+ * says nothing about scaling
+ *
+ * usage: builder_benchmark [products]
+ */
+
+template <typename Function>
+double measure(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::vector<Recipe> recipes(count);
+    for (std::size_t i = 0; i < count; ++i)
+        recipes[i] = i % 2 == 0 ? Recipe::All : Recipe::A;
+
+    auto construct = [&]() {
+        std::shared_ptr<ConcreteBuilderX> builder =
+            std::make_shared<ConcreteBuilderX>();
+        Director director;
+        director.setBuilder(builder);
+
+        std::vector<std::unique_ptr<Product>> products(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (recipes[i] == Recipe::A)
+                director.constructA();
+            else
+                director.constructAll();
+            products[i] = builder->getProduct();
+        }
+    };
+
+    // the first run fills the arena pool, later runs recycle its arenas
+    construct();
+    double serial = measure(construct);
+    std::cout << "serial: " << count / serial << " products/s\n";
+
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    if (cores == 1)
+        std::cout << "one hardware thread, parallel scaling not measured\n";
+    for (std::size_t workers = 1; workers <= cores; workers *= 2) {
+        ParallelDirector<ConcreteBuilderX> director(workers);
+        director.construct(recipes);
+        double parallel = measure([&]() { director.construct(recipes); });
+        std::cout << workers << " workers: " << count / parallel
+                  << " products/s, speedup " << serial / parallel << "\n";
+    }
+}
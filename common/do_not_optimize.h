@@ -0,0 +1,22 @@
+#ifndef COMMON_DO_NOT_OPTIMIZE_H
+#define COMMON_DO_NOT_OPTIMIZE_H
+
+/*
+ * Optimization barrier
+ * makes the compiler assume value is read and memory is written, so an
+ * object that is created and never used is still created and a loop
+ * that only updates memory is not folded; benchmarks pass what they
+ * create or update here instead of querying it, which would add the
+ * query's own work to the measurement
+ */
+template <typename T>
+void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void *volatile escape;
+    escape = &value;
+#endif
+}
+
+#endif
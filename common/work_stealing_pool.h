@@ -0,0 +1,118 @@
+#ifndef COMMON_WORK_STEALING_POOL_H
+#define COMMON_WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Work Stealing Pool
+ * runs a batch of chunks on persistent worker threads; chunks are dealt
+ * round robin into per-worker queues, a worker takes its own chunks from
+ * the back and steals from the front of the others once it runs dry
+ */
+class WorkStealingPool {
+   public:
+    using Task = std::function<void(std::size_t worker, std::size_t chunk)>;
+
+    explicit WorkStealingPool(
+        std::size_t workers = std::max(1u, std::thread::hardware_concurrency()))
+        : queues(workers) {
+        for (std::size_t i = 0; i < workers; ++i)
+            threads.emplace_back([this, i]() { work(i); });
+    }
+
+    WorkStealingPool(WorkStealingPool const &) = delete;
+    WorkStealingPool &operator=(WorkStealingPool const &) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for (std::thread &thread : threads) thread.join();
+    }
+
+    std::size_t size() const { return threads.size(); }
+
+    // runs task for every chunk in [0, chunks) and returns when all are done
+    void run(std::size_t chunks, Task task) {
+        if (chunks == 0) return;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        job = std::move(task);
+        pending = chunks;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            Queue &queue = queues[chunk % queues.size()];
+            std::lock_guard<std::mutex> queueLock(queue.mutex);
+            queue.chunks.push_back(chunk);
+        }
+        ++generation;
+        wake.notify_all();
+        done.wait(lock, [this]() { return pending == 0; });
+    }
+
+   private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::size_t> chunks;
+    };
+
+    void work(std::size_t self) {
+        std::size_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&]() { return stop || generation != seen; });
+                if (stop) return;
+                seen = generation;
+            }
+
+            std::size_t chunk;
+            while (take(self, chunk)) {
+                job(self, chunk);
+                if (pending.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done.notify_all();
+                }
+            }
+        }
+    }
+
+    bool take(std::size_t self, std::size_t &chunk) {
+        for (std::size_t i = 0; i < queues.size(); ++i) {
+            Queue &queue = queues[(self + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.chunks.empty()) continue;
+
+            if (i == 0) {
+                chunk = queue.chunks.back();
+                queue.chunks.pop_back();
+            } else {
+                chunk = queue.chunks.front();
+                queue.chunks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    Task job;
+    std::atomic<std::size_t> pending{0};
+    std::size_t generation = 0;
+    bool stop = false;
+};
+
+#endif
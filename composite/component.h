@@ -0,0 +1,243 @@
+#ifndef COMPOSITE_COMPONENT_H
+#define COMPOSITE_COMPONENT_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Rope
+ * immutable text made of owned pieces and shared sub-ropes; joining
+ * ropes links them instead of copying their text, and write() appends
+ * the whole rope to a buffer after reserving its known size once, so
+ * producing a result costs O(output size) however deep the tree is
+ */
+class Rope {
+   public:
+    Rope() = default;
+    explicit Rope(std::string text) { append(std::move(text)); }
+
+    // appends text to the rope under construction
+    Rope &append(std::string text) {
+        mutableNode().length += text.size();
+        mutableNode().pieces.push_back(Piece{std::move(text), {}});
+        return *this;
+    }
+    // appends another rope, sharing rather than copying its text
+    Rope &append(const Rope &other) {
+        if (!other.node) return *this;
+        mutableNode().length += other.node->length;
+        mutableNode().pieces.push_back(Piece{{}, other.node});
+        return *this;
+    }
+
+    std::size_t size() const { return node ? node->length : 0; }
+
+    void write(std::string &out) const {
+        if (!node) return;
+        out.reserve(out.size() + node->length);
+
+        std::vector<std::pair<const Node *, std::size_t>> stack{
+            {node.get(), 0}};
+        while (!stack.empty()) {
+            auto &[current, next] = stack.back();
+            if (next == current->pieces.size()) {
+                stack.pop_back();
+                continue;
+            }
+
+            const Piece &piece = current->pieces[next++];
+            if (piece.rope)
+                stack.emplace_back(piece.rope.get(), 0);
+            else
+                out += piece.text;
+        }
+    }
+
+    std::string str() const {
+        std::string out;
+        write(out);
+        return out;
+    }
+
+   private:
+    struct Node;
+
+    struct Piece {
+        std::string text;
+        std::shared_ptr<const Node> rope;
+    };
+
+    struct Node {
+        std::size_t length = 0;
+        std::vector<Piece> pieces;
+    };
+
+    // copies a shared node before the first change, so appending to a
+    // copy of a cached rope never changes the cache
+    Node &mutableNode() {
+        if (!node)
+            node = std::make_shared<Node>();
+        else if (node.use_count() != 1)
+            node = std::make_shared<Node>(*node);
+        return const_cast<Node &>(*node);
+    }
+
+    std::shared_ptr<const Node> node;
+};
+
+/*
+ * Component
+ * defines an interface for all objects in the composition
+ * both the composite and the leaf nodes; result() caches the node's
+ * rope until markDirty() is called on the node or anything below it,
+ * which dirties the node and its parent chain so only changed paths are
+ * evaluated again; operation() and write() flatten the rope in one pass;
+ * the caches are filled without synchronization, so a Component tree is
+ * evaluated on one thread and FlatTree is the storage for parallel runs
+ */
+struct CacheStats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+};
+
+class Component {
+   public:
+    Component() : parent(nullptr) {}
+    virtual ~Component() {
+        if (parent) parent->markDirty();
+    }
+    void setParent(std::shared_ptr<Component> parent) { this->parent = parent; }
+    std::shared_ptr<Component> getParent() const { return parent; }
+    virtual void add(std::shared_ptr<Component> component) {}
+    virtual void remove(std::shared_ptr<Component> component) {}
+    virtual bool isComposite() const { return false; }
+
+    std::string operation() const { return result().str(); }
+    void write(std::string &out) const { result().write(out); }
+
+    const Rope &result() const {
+        if (!dirty) {
+            ++getCacheStats().hits;
+            return cache;
+        }
+        ++getCacheStats().misses;
+        cache = evaluate();
+        dirty = false;
+        return cache;
+    }
+
+    // a dirty node always has a dirty parent chain, so the walk can stop
+    // at the first node that is already dirty
+    void markDirty() {
+        for (Component *node = this; node && !node->dirty;
+             node = node->parent.get())
+            node->dirty = true;
+    }
+
+    static CacheStats &getCacheStats() {
+        static CacheStats stats;
+        return stats;
+    }
+
+   protected:
+    virtual Rope evaluate() const = 0;
+
+    std::shared_ptr<Component> parent;
+
+   private:
+    mutable Rope cache;
+    mutable bool dirty = true;
+};
+
+/*
+ * Leaf
+ * defines the behavior for the elements in the composition,
+ * it has no children
+ */
+class Leaf : public Component {
+   public:
+    explicit Leaf(std::string name = "Leaf") : name(std::move(name)) {}
+
+    const std::string &getName() const { return name; }
+    void setName(std::string name) {
+        this->name = std::move(name);
+        markDirty();
+    }
+
+   protected:
+    Rope evaluate() const override { return Rope(name); }
+
+   private:
+    std::string name;
+};
+
+/*
+ * Composite
+ * defines behavior of the components having children
+ * and store child components
+ */
+class Composite : public Component,
+                  public std::enable_shared_from_this<Composite> {
+   public:
+    virtual ~Composite() { children.clear(); }
+    // a child has one parent, so adding it here detaches it from the last
+    void add(std::shared_ptr<Component> component) {
+        if (std::shared_ptr<Component> old = component->getParent())
+            old->remove(component);
+
+        std::weak_ptr<Component> wComp = component;
+        children.push_back(wComp);
+        component->setParent(shared_from_this());
+        markDirty();
+    }
+    void remove(std::shared_ptr<Component> component) {
+        auto i = children.begin();
+        while (i != children.end()) {
+            std::shared_ptr<Component> comp = i->lock();
+
+            if (comp == component) {
+                i = children.erase(i);
+                comp->setParent(nullptr);
+                markDirty();
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    bool isComposite() const override { return true; }
+
+    std::vector<std::shared_ptr<Component>> getChildren() const {
+        std::vector<std::shared_ptr<Component>> result;
+        for (const std::weak_ptr<Component> &child : children)
+            if (std::shared_ptr<Component> comp = child.lock())
+                result.push_back(comp);
+        return result;
+    }
+
+   protected:
+    Rope evaluate() const override {
+        Rope result;
+        result.append("Branch(");
+        // children that were destroyed are skipped, like in getChildren(),
+        // and separators only go between the children actually written
+        bool first = true;
+        for (const std::weak_ptr<Component> &wComp : children) {
+            std::shared_ptr<Component> comp = wComp.lock();
+            if (!comp) continue;
+
+            if (!first) result.append("+");
+            result.append(comp->result());
+            first = false;
+        }
+        result.append(")");
+        return result;
+    }
+
+    std::vector<std::weak_ptr<Component>> children;
+};
+
+#endif
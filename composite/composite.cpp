@@ -1,81 +1,11 @@
+#include <filesystem>
 #include <iostream>
 #include <memory>
-#include <vector>
+#include <string>
 
-/*
- * Component
- * defines an interface for all objects in the composition
- * both the composite and the leaf nodes
- */
-class Component {
-   public:
-    Component() : parent(nullptr) {}
-    virtual ~Component() = default;
-    void setParent(std::shared_ptr<Component> parent) { this->parent = parent; }
-    std::shared_ptr<Component> getParent() const { return parent; }
-    virtual void add(std::shared_ptr<Component> component) {}
-    virtual void remove(std::shared_ptr<Component> component) {}
-    virtual bool isComposite() const { return false; }
-    virtual std::string operation() const = 0;
-
-   protected:
-    std::shared_ptr<Component> parent;
-};
-
-/*
- * Leaf
- * defines the behavior for the elements in the composition,
- * it has no children
- */
-class Leaf : public Component {
-   public:
-    std::string operation() const override { return "Leaf"; }
-};
-
-/*
- * Composite
- * defines behavior of the components having children
- * and store child components
- */
-class Composite : public Component,
-                  public std::enable_shared_from_this<Composite> {
-   public:
-    virtual ~Composite() { children.clear(); }
-    void add(std::shared_ptr<Component> component) {
-        std::weak_ptr<Component> wComp = component;
-        children.push_back(wComp);
-        component->setParent(shared_from_this());
-    }
-    void remove(std::shared_ptr<Component> component) {
-        auto i = children.begin();
-        while (i != children.end()) {
-            std::shared_ptr<Component> comp = i->lock();
-
-            if (comp == component)
-                i = children.erase(i);
-            else
-                ++i;
-        }
-    }
-
-    bool isComposite() const override { return true; }
-    std::string operation() const override {
-        std::string result;
-        for (int i = 0; i < children.size(); ++i) {
-            std::weak_ptr<Component> wComp = children[i];
-            std::shared_ptr<Component> comp = wComp.lock();
-
-            if (i == children.size() - 1)
-                result += comp->operation();
-            else
-                result += comp->operation() + "+";
-        }
-        return "Branch(" + result + ")";
-    }
-
-   protected:
-    std::vector<std::weak_ptr<Component>> children;
-};
+#include "component.h"
+#include "flat_tree.h"
+#include "tree_file.h"
 
 int main() {
     std::shared_ptr<Component> simple = std::make_shared<Leaf>();
@@ -103,4 +33,44 @@ int main() {
     tree->remove(simple);
     tree->remove(branch2);
     std::cout << "Result: " << tree->operation() << "\n";
+
+    std::static_pointer_cast<Leaf>(leaf_1)->setName("Changed");
+    std::cout << "Result: " << tree->operation() << "\n";
+    std::cout << "Cache hits: " << Component::getCacheStats().hits
+              << ", misses: " << Component::getCacheStats().misses << "\n";
+
+    FlatTree flat;
+    FlatNode root(flat, flat.createComposite());
+    FlatNode branch(flat, flat.createComposite());
+    FlatNode leaf(flat, flat.createLeaf());
+    branch.add(FlatNode(flat, flat.createLeaf()));
+    branch.add(FlatNode(flat, flat.createLeaf()));
+    root.add(branch);
+    root.add(leaf);
+    std::cout << "Flat result: " << root.operation() << "\n";
+
+    WorkStealingPool pool;
+    std::cout << "Parallel flat result: " << root.operationParallel(pool, 1)
+              << "\n";
+
+    root.remove(branch);
+    std::cout << "Flat result: " << root.operation() << "\n";
+
+#ifdef COMPOSITE_MMAP
+    std::string path =
+        (std::filesystem::temp_directory_path() / "composite.tree").string();
+    TreeWriter::write(path, *tree);
+    {
+        MappedTree mapped(path);
+        std::cout << "Mapped result: " << mapped.operation(mapped.getRoot())
+                  << "\n";
+    }
+    TreeWriter::write(path, flat, branch.getId());
+    {
+        MappedTree mapped(path);
+        std::cout << "Mapped flat result: "
+                  << mapped.operation(mapped.getRoot()) << "\n";
+    }
+    std::filesystem::remove(path);
+#endif
 }
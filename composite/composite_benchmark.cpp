@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flat_tree.h"
+#include "tree_file.h"
+
+/*
+ * Benchmark of Composite traversal: builds the same tree with the
+ * shared_ptr/weak_ptr Composite and with FlatTree and times building
+ * it and running operation() on its root, then runs FlatTree's
+ * operationParallel() with a growing number of workers, and finally
+ * snapshots the FlatTree to a tree file and times mapping it back
+ *
+ * usage: composite_benchmark [nodes] [fanout]
+ */
+
+// the shared_ptr/weak_ptr Composite as it was before the caching and
+// flat storage changes, kept here as the reference point
+namespace baseline {
+/*
+ * Component
+ * defines an interface for all objects in the composition
+ * both the composite and the leaf nodes
+ */
+class Component {
+   public:
+    Component() : parent(nullptr) {}
+    virtual ~Component() = default;
+    void setParent(std::shared_ptr<Component> parent) { this->parent = parent; }
+    std::shared_ptr<Component> getParent() const { return parent; }
+    virtual void add(std::shared_ptr<Component>) {}
+    virtual void remove(std::shared_ptr<Component>) {}
+    virtual bool isComposite() const { return false; }
+    virtual std::string operation() const = 0;
+
+   protected:
+    std::shared_ptr<Component> parent;
+};
+
+/*
+ * Leaf
+ * defines the behavior for the elements in the composition,
+ * it has no children
+ */
+class Leaf : public Component {
+   public:
+    std::string operation() const override { return "Leaf"; }
+};
+
+/*
+ * Composite
+ * defines behavior of the components having children
+ * and store child components
+ */
+class Composite : public Component,
+                  public std::enable_shared_from_this<Composite> {
+   public:
+    virtual ~Composite() { children.clear(); }
+    void add(std::shared_ptr<Component> component) {
+        std::weak_ptr<Component> wComp = component;
+        children.push_back(wComp);
+        component->setParent(shared_from_this());
+    }
+    void remove(std::shared_ptr<Component> component) {
+        auto i = children.begin();
+        while (i != children.end()) {
+            std::shared_ptr<Component> comp = i->lock();
+
+            if (comp == component)
+                i = children.erase(i);
+            else
+                ++i;
+        }
+    }
+
+    bool isComposite() const override { return true; }
+    std::string operation() const override {
+        std::string result;
+        for (std::size_t i = 0; i < children.size(); ++i) {
+            std::weak_ptr<Component> wComp = children[i];
+            std::shared_ptr<Component> comp = wComp.lock();
+
+            if (i == children.size() - 1)
+                result += comp->operation();
+            else
+                result += comp->operation() + "+";
+        }
+        return "Branch(" + result + ")";
+    }
+
+   protected:
+    std::vector<std::weak_ptr<Component>> children;
+};
+}  // namespace baseline
+
+template <typename Function>
+double measure(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t nodes = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    const std::size_t fanout = argc > 2 ? std::stoul(argv[2]) : 8;
+    // node i is the child of node (i - 1) / fanout; inner nodes are
+    // composites and the rest are leaves
+    auto isInner = [&](std::size_t i) { return i * fanout + 1 < nodes; };
+
+    std::vector<std::shared_ptr<baseline::Component>> components;
+    double build = measure([&]() {
+        components.reserve(nodes);
+        for (std::size_t i = 0; i < nodes; ++i) {
+            if (isInner(i))
+                components.push_back(std::make_shared<baseline::Composite>());
+            else
+                components.push_back(std::make_shared<baseline::Leaf>());
+            if (i > 0) components[(i - 1) / fanout]->add(components[i]);
+        }
+    });
+    std::size_t length = 0;
+    double traverse =
+        measure([&]() { length = components[0]->operation().size(); });
+    std::cout << "shared_ptr Composite: build " << build << " ms, operation "
+              << traverse << " ms (" << length << " chars)\n";
+
+    FlatTree tree;
+    build = measure([&]() {
+        for (std::size_t i = 0; i < nodes; ++i) {
+            if (isInner(i))
+                tree.createComposite();
+            else
+                tree.createLeaf();
+            if (i > 0)
+                tree.add(static_cast<FlatTree::NodeId>((i - 1) / fanout),
+                         static_cast<FlatTree::NodeId>(i));
+        }
+    });
+    traverse = measure([&]() { length = tree.operation(0).size(); });
+    std::cout << "FlatTree: build " << build << " ms, operation " << traverse
+              << " ms (" << length << " chars)\n";
+
+    std::string serial = tree.operation(0);
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t workers = 1; workers <= cores; workers *= 2) {
+        WorkStealingPool pool(workers);
+        std::string parallel;
+        traverse = measure([&]() { parallel = tree.operationParallel(0, pool); });
+        std::cout << "FlatTree parallel, " << workers << " workers: operation "
+                  << traverse << " ms"
+                  << (parallel == serial ? "" : " (MISMATCH)") << "\n";
+    }
+
+    // one root with every other node as a leaf child
+    FlatTree wide;
+    wide.createComposite();
+    for (std::size_t i = 1; i < nodes; ++i) wide.add(0, wide.createLeaf());
+    std::string wideSerial;
+    traverse = measure([&]() { wideSerial = wide.operation(0); });
+    std::cout << "Wide FlatTree: operation " << traverse << " ms\n";
+    for (std::size_t workers = 1; workers <= cores; workers *= 2) {
+        WorkStealingPool pool(workers);
+        std::string parallel;
+        traverse = measure([&]() { parallel = wide.operationParallel(0, pool); });
+        std::cout << "Wide FlatTree parallel, " << workers
+                  << " workers: operation " << traverse << " ms"
+                  << (parallel == wideSerial ? "" : " (MISMATCH)") << "\n";
+    }
+
+#ifdef COMPOSITE_MMAP
+    std::string path =
+        (std::filesystem::temp_directory_path() / "composite_benchmark.tree")
+            .string();
+    build = measure([&]() { TreeWriter::write(path, tree, 0); });
+    {
+        std::unique_ptr<MappedTree> mapped;
+        double load =
+            measure([&]() { mapped = std::make_unique<MappedTree>(path); });
+        std::string result;
+        traverse = measure(
+            [&]() { result = mapped->operation(mapped->getRoot()); });
+        std::cout << "MappedTree: write " << build << " ms, load " << load
+                  << " ms, operation " << traverse << " ms"
+                  << (result == serial ? "" : " (MISMATCH)") << "\n";
+    }
+    std::filesystem::remove(path);
+#endif
+}
@@ -0,0 +1,271 @@
+#ifndef COMPOSITE_FLAT_TREE_H
+#define COMPOSITE_FLAT_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../common/work_stealing_pool.h"
+
+/*
+ * Flat Tree
+ * alternative storage for large compositions: nodes live in contiguous
+ * arrays and link to each other through 32-bit indices (parent, first
+ * and last child, previous and next sibling), so traversal walks arrays
+ * instead of locking weak pointers to scattered heap nodes
+ */
+class FlatTree {
+   public:
+    using NodeId = std::uint32_t;
+    static constexpr NodeId none = UINT32_MAX;
+
+    NodeId createLeaf() { return create(false); }
+    NodeId createComposite() { return create(true); }
+
+    bool isComposite(NodeId node) const { return composite[node] != 0; }
+    NodeId getParent(NodeId node) const { return parent[node]; }
+    NodeId getFirstChild(NodeId node) const { return firstChild[node]; }
+    NodeId getNextSibling(NodeId node) const { return nextSibling[node]; }
+    std::size_t size() const { return parent.size(); }
+
+    void add(NodeId node, NodeId child) {
+        if (!composite[node]) return;
+        if (parent[child] != none) remove(parent[child], child);
+
+        parent[child] = node;
+        prevSibling[child] = lastChild[node];
+        if (lastChild[node] != none)
+            nextSibling[lastChild[node]] = child;
+        else
+            firstChild[node] = child;
+        lastChild[node] = child;
+    }
+
+    void remove(NodeId node, NodeId child) {
+        if (parent[child] != node) return;
+
+        if (prevSibling[child] != none)
+            nextSibling[prevSibling[child]] = nextSibling[child];
+        else
+            firstChild[node] = nextSibling[child];
+        if (nextSibling[child] != none)
+            prevSibling[nextSibling[child]] = prevSibling[child];
+        else
+            lastChild[node] = prevSibling[child];
+
+        parent[child] = prevSibling[child] = nextSibling[child] = none;
+    }
+
+    // walks the subtree with an explicit stack, so deep trees cannot
+    // overflow the call stack, and writes into a single string
+    std::string operation(NodeId node) const {
+        std::string result;
+        write(node, node, result);
+        return result;
+    }
+
+    // splits the subtree into tasks of about cutoff nodes each: runs of
+    // consecutive small siblings are grouped into one task, and only the
+    // composites larger than cutoff are left to a serial walk that
+    // stitches the task results together, so the result is identical to
+    // operation() and a wide tree does not turn into one task per leaf;
+    // sizes are only counted up to cutoff, so planning visits the nodes
+    // above the task frontier rather than the whole subtree, and after
+    // 64 splits per worker the remaining large composites become tasks
+    // of their own, which bounds planning on deep chains
+    std::string operationParallel(NodeId node, WorkStealingPool &pool,
+                                  std::size_t cutoff = 4096) const {
+        cutoff = std::max<std::size_t>(cutoff, 1);
+        std::vector<NodeId> stack;
+        if (countUpTo(node, cutoff, stack) <= cutoff) return operation(node);
+
+        // a range covers the siblings from first to last
+        struct Range {
+            NodeId first;
+            NodeId last;
+        };
+        // the ranges and the split children of a split composite start
+        // at firstRange and firstSplit
+        struct Split {
+            NodeId node;
+            std::size_t firstRange;
+            std::size_t firstSplit;
+        };
+        std::vector<Range> ranges;
+        std::vector<Split> splits{Split{node, 0, 0}};
+        const std::size_t maxSplits = 64 * pool.size();
+
+        for (std::size_t i = 0; i < splits.size(); ++i) {
+            splits[i].firstRange = ranges.size();
+            splits[i].firstSplit = splits.size();
+            std::size_t grouped = 0;
+            bool grouping = false;
+            for (NodeId child = firstChild[splits[i].node]; child != none;
+                 child = nextSibling[child]) {
+                std::size_t size = countUpTo(child, cutoff, stack);
+                if (size > cutoff) {
+                    if (splits.size() < maxSplits)
+                        splits.push_back(Split{child, 0, 0});
+                    else
+                        ranges.push_back(Range{child, child});
+                    grouping = false;
+                    continue;
+                }
+                if (!grouping || grouped + size > cutoff) {
+                    ranges.push_back(Range{child, child});
+                    grouped = 0;
+                    grouping = true;
+                }
+                ranges.back().last = child;
+                grouped += size;
+            }
+        }
+
+        std::vector<std::string> results(ranges.size());
+        pool.run(ranges.size(), [&](std::size_t, std::size_t task) {
+            write(ranges[task].first, ranges[task].last, results[task]);
+        });
+
+        std::size_t length = 0;
+        for (const std::string &text : results) length += text.size();
+
+        // one entry per open composite: the next child to write and the
+        // next of its ranges and split children
+        struct Open {
+            NodeId next;
+            std::size_t range;
+            std::size_t split;
+        };
+        std::string result;
+        result.reserve(length + splits.size() * sizeof("Branch()+"));
+        result += "Branch(";
+        std::vector<Open> open{
+            Open{firstChild[node], splits[0].firstRange, splits[0].firstSplit}};
+        while (!open.empty()) {
+            Open &top = open.back();
+            NodeId current = top.next;
+            if (current == none) {
+                result += ')';
+                open.pop_back();
+                continue;
+            }
+            if (prevSibling[current] != none) result += '+';
+
+            if (top.range < ranges.size() &&
+                ranges[top.range].first == current) {
+                result += results[top.range];
+                top.next = nextSibling[ranges[top.range].last];
+                ++top.range;
+            } else {
+                const Split &split = splits[top.split++];
+                top.next = nextSibling[current];
+                result += "Branch(";
+                open.push_back(Open{firstChild[split.node], split.firstRange,
+                                    split.firstSplit});
+            }
+        }
+        return result;
+    }
+
+   private:
+    // writes the siblings from first to last, separated like in their
+    // parent, with one stack shared by the whole range
+    void write(NodeId first, NodeId last, std::string &result) const {
+        std::vector<NodeId> stack;
+        for (NodeId node = first;; node = nextSibling[node]) {
+            stack.push_back(node);
+            if (node == last) break;
+        }
+        std::reverse(stack.begin(), stack.end());
+
+        while (!stack.empty()) {
+            NodeId current = stack.back();
+            stack.pop_back();
+
+            if (current == none) {
+                result += ')';
+                continue;
+            }
+            if (current != first && prevSibling[current] != none)
+                result += '+';
+            if (!composite[current]) {
+                result += "Leaf";
+                continue;
+            }
+
+            result += "Branch(";
+            stack.push_back(none);
+            std::size_t first = stack.size();
+            for (NodeId child = firstChild[current]; child != none;
+                 child = nextSibling[child])
+                stack.push_back(child);
+            std::reverse(stack.begin() + first, stack.end());
+        }
+    }
+
+    // number of nodes in the subtree of node, counted up to limit + 1;
+    // stack is scratch space kept by the caller across calls
+    std::size_t countUpTo(NodeId node, std::size_t limit,
+                          std::vector<NodeId> &stack) const {
+        if (!composite[node]) return 1;
+
+        std::size_t count = 1;
+        stack.assign(1, node);
+        while (!stack.empty()) {
+            NodeId current = stack.back();
+            stack.pop_back();
+            if (!composite[current]) continue;
+
+            for (NodeId child = firstChild[current]; child != none;
+                 child = nextSibling[child]) {
+                if (++count > limit) return count;
+                stack.push_back(child);
+            }
+        }
+        return count;
+    }
+
+    NodeId create(bool isComposite) {
+        composite.push_back(isComposite ? 1 : 0);
+        for (std::vector<NodeId> *links :
+             {&parent, &firstChild, &lastChild, &prevSibling, &nextSibling})
+            links->push_back(none);
+        return static_cast<NodeId>(parent.size() - 1);
+    }
+
+    std::vector<std::uint8_t> composite;
+    std::vector<NodeId> parent;
+    std::vector<NodeId> firstChild;
+    std::vector<NodeId> lastChild;
+    std::vector<NodeId> prevSibling;
+    std::vector<NodeId> nextSibling;
+};
+
+/*
+ * Flat Node
+ * handle to a node of a FlatTree that offers the Component API
+ */
+class FlatNode {
+   public:
+    FlatNode(FlatTree &tree, FlatTree::NodeId id) : tree(&tree), id(id) {}
+
+    FlatTree::NodeId getId() const { return id; }
+    FlatNode getParent() const { return FlatNode(*tree, tree->getParent(id)); }
+    bool isNull() const { return id == FlatTree::none; }
+    void add(FlatNode component) { tree->add(id, component.id); }
+    void remove(FlatNode component) { tree->remove(id, component.id); }
+    bool isComposite() const { return tree->isComposite(id); }
+    std::string operation() const { return tree->operation(id); }
+    std::string operationParallel(WorkStealingPool &pool,
+                                  std::size_t cutoff = 4096) const {
+        return tree->operationParallel(id, pool, cutoff);
+    }
+
+   private:
+    FlatTree *tree;
+    FlatTree::NodeId id;
+};
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef COMPOSITE_TREE_FILE_H
+#define COMPOSITE_TREE_FILE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define COMPOSITE_MMAP 1
+#endif
+
+#include "component.h"
+#include "flat_tree.h"
+
+/*
+ * Tree File
+ * binary snapshot of a composition laid out to be used straight from a
+ * read-only memory mapping: a header, the nodes in depth-first order
+ * linked by 32-bit indices like FlatTree, then the leaf names; values
+ * are stored in host byte order
+ */
+namespace treeFile {
+constexpr char magic[8] = {'C', 'M', 'P', 'T', 'R', 'E', 'E', '1'};
+constexpr std::uint32_t version = 1;
+constexpr std::uint32_t none = UINT32_MAX;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t nodeCount;
+    std::uint64_t namesSize;
+};
+
+struct Node {
+    std::uint32_t parent;
+    std::uint32_t firstChild;
+    std::uint32_t nextSibling;
+    std::uint32_t composite;
+    std::uint32_t nameOffset;
+    std::uint32_t nameLength;
+};
+}  // namespace treeFile
+
+/*
+ * Tree Writer
+ * snapshots a Component tree or a FlatTree subtree into a tree file
+ */
+class TreeWriter {
+   public:
+    static void write(const std::string &path, const Component &root) {
+        write(
+            path, &root,
+            [](const Component *node) { return node->isComposite(); },
+            [](const Component *node) {
+                std::vector<const Component *> result;
+                for (const std::shared_ptr<Component> &child :
+                     static_cast<const Composite *>(node)->getChildren())
+                    result.push_back(child.get());
+                return result;
+            },
+            [](const Component *node) {
+                return static_cast<const Leaf *>(node)->getName();
+            });
+    }
+
+    static void write(const std::string &path, const FlatTree &tree,
+                      FlatTree::NodeId root) {
+        write(
+            path, root,
+            [&tree](FlatTree::NodeId node) { return tree.isComposite(node); },
+            [&tree](FlatTree::NodeId node) {
+                std::vector<FlatTree::NodeId> result;
+                FlatTree::NodeId child = tree.getFirstChild(node);
+                for (; child != FlatTree::none; child = tree.getNextSibling(child))
+                    result.push_back(child);
+                return result;
+            },
+            [](FlatTree::NodeId) { return std::string("Leaf"); });
+    }
+
+   private:
+    template <typename NodeRef, typename IsComposite, typename Children,
+              typename Name>
+    static void write(const std::string &path, NodeRef root,
+                      IsComposite isComposite, Children children, Name name) {
+        std::vector<treeFile::Node> nodes;
+        std::vector<std::uint32_t> lastChild;
+        std::string names;
+        std::unordered_map<std::string, std::uint32_t> nameOffsets;
+
+        std::vector<std::pair<NodeRef, std::uint32_t>> stack{
+            {root, treeFile::none}};
+        while (!stack.empty()) {
+            auto [node, parent] = stack.back();
+            stack.pop_back();
+
+            if (nodes.size() >= treeFile::none)
+                throw std::length_error("too many nodes for a tree file");
+            const auto index = static_cast<std::uint32_t>(nodes.size());
+            const bool composite = isComposite(node);
+            treeFile::Node entry{parent, treeFile::none, treeFile::none,
+                                 composite ? 1u : 0u, 0, 0};
+            if (!composite) {
+                std::string leafName = name(node);
+                if (leafName.size() > UINT32_MAX - names.size())
+                    throw std::length_error("leaf names exceed a tree file");
+                auto offset = nameOffsets.emplace(
+                    leafName, static_cast<std::uint32_t>(names.size()));
+                if (offset.second) names += leafName;
+                entry.nameOffset = offset.first->second;
+                entry.nameLength = static_cast<std::uint32_t>(leafName.size());
+            }
+            nodes.push_back(entry);
+            lastChild.push_back(treeFile::none);
+
+            if (parent != treeFile::none) {
+                if (lastChild[parent] == treeFile::none)
+                    nodes[parent].firstChild = index;
+                else
+                    nodes[lastChild[parent]].nextSibling = index;
+                lastChild[parent] = index;
+            }
+            if (!composite) continue;
+            std::vector<NodeRef> kids = children(node);
+            for (auto kid = kids.rbegin(); kid != kids.rend(); ++kid)
+                stack.emplace_back(*kid, index);
+        }
+
+        treeFile::Header header{};
+        std::memcpy(header.magic, treeFile::magic, sizeof(header.magic));
+        header.version = treeFile::version;
+        header.nodeCount = static_cast<std::uint32_t>(nodes.size());
+        header.namesSize = names.size();
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(nodes.data()),
+                   nodes.size() * sizeof(treeFile::Node));
+        file.write(names.data(), names.size());
+        if (!file) throw std::runtime_error("cannot write tree file " + path);
+    }
+};
+
+#ifdef COMPOSITE_MMAP
+/*
+ * Mapped Tree
+ * maps a tree file read-only and traverses it in place; loading costs
+ * one mmap call and a single pass that checks every link and name lies
+ * inside the file, so a damaged file is rejected up front instead of
+ * being followed out of bounds
+ */
+class MappedTree {
+   public:
+    using NodeId = std::uint32_t;
+    static constexpr NodeId none = treeFile::none;
+
+    explicit MappedTree(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open tree file " + path);
+
+        struct stat status;
+        if (::fstat(fd, &status) == 0)
+            length = static_cast<std::size_t>(status.st_size);
+        if (length >= sizeof(treeFile::Header))
+            data = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED || data == nullptr) {
+            data = nullptr;
+            throw std::runtime_error("cannot map tree file " + path);
+        }
+
+        header = static_cast<const treeFile::Header *>(data);
+        nodes = reinterpret_cast<const treeFile::Node *>(header + 1);
+        names = reinterpret_cast<const char *>(nodes + header->nodeCount);
+        if (!valid()) {
+            ::munmap(data, length);
+            throw std::runtime_error("invalid tree file " + path);
+        }
+    }
+
+    MappedTree(MappedTree const &) = delete;
+    MappedTree &operator=(MappedTree const &) = delete;
+
+    ~MappedTree() { ::munmap(data, length); }
+
+    std::size_t size() const { return header->nodeCount; }
+    NodeId getRoot() const { return header->nodeCount == 0 ? none : 0; }
+    NodeId getParent(NodeId node) const { return nodes[node].parent; }
+    NodeId getFirstChild(NodeId node) const { return nodes[node].firstChild; }
+    NodeId getNextSibling(NodeId node) const { return nodes[node].nextSibling; }
+    bool isComposite(NodeId node) const { return nodes[node].composite != 0; }
+    std::string_view getName(NodeId node) const {
+        return std::string_view(names + nodes[node].nameOffset,
+                                nodes[node].nameLength);
+    }
+
+    // same walk as FlatTree::operation, with the separators and closing
+    // brackets pushed onto the stack as marker ids
+    std::string operation(NodeId node) const {
+        constexpr NodeId close = none;
+        constexpr NodeId separator = none - 1;
+
+        std::string result;
+        std::vector<NodeId> stack{node};
+        while (!stack.empty()) {
+            NodeId current = stack.back();
+            stack.pop_back();
+
+            if (current == close) {
+                result += ')';
+            } else if (current == separator) {
+                result += '+';
+            } else if (!isComposite(current)) {
+                result += getName(current);
+            } else {
+                result += "Branch(";
+                stack.push_back(close);
+                std::size_t first = stack.size();
+                for (NodeId child = nodes[current].firstChild; child != none;
+                     child = nodes[child].nextSibling) {
+                    if (child != nodes[current].firstChild)
+                        stack.push_back(separator);
+                    stack.push_back(child);
+                }
+                std::reverse(stack.begin() + first, stack.end());
+            }
+        }
+        return result;
+    }
+
+   private:
+    // the writer emits nodes in depth-first order, so child and sibling
+    // links always point forward; requiring that also rules out cycles,
+    // and requiring every node to be linked to at most once, with parent
+    // fields that agree with the links, rules out shared subtrees
+    bool valid() const {
+        if (std::memcmp(header->magic, treeFile::magic, sizeof(header->magic)) ||
+            header->version != treeFile::version)
+            return false;
+
+        const std::uint64_t count = header->nodeCount;
+        const std::uint64_t available = length - sizeof(treeFile::Header);
+        const std::uint64_t nodesSize = count * sizeof(treeFile::Node);
+        if (nodesSize > available ||
+            header->namesSize != available - nodesSize)
+            return false;
+
+        auto inRange = [count](NodeId link) {
+            return link == none || link < count;
+        };
+        if (count > 0 && nodes[0].parent != none) return false;
+
+        std::vector<bool> linked(count, false);
+        for (NodeId node = 0; node < count; ++node) {
+            const treeFile::Node &entry = nodes[node];
+            if (!inRange(entry.parent) || !inRange(entry.firstChild) ||
+                !inRange(entry.nextSibling) || entry.composite > 1)
+                return false;
+            if ((entry.firstChild != none && entry.firstChild <= node) ||
+                (entry.nextSibling != none && entry.nextSibling <= node))
+                return false;
+            if (entry.firstChild != none) {
+                if (linked[entry.firstChild] ||
+                    nodes[entry.firstChild].parent != node)
+                    return false;
+                linked[entry.firstChild] = true;
+            }
+            if (entry.nextSibling != none) {
+                if (linked[entry.nextSibling] || entry.parent == none ||
+                    nodes[entry.nextSibling].parent != entry.parent)
+                    return false;
+                linked[entry.nextSibling] = true;
+            }
+            if (std::uint64_t{entry.nameOffset} + entry.nameLength >
+                header->namesSize)
+                return false;
+        }
+        return true;
+    }
+
+    void *data = nullptr;
+    std::size_t length = 0;
+    const treeFile::Header *header = nullptr;
+    const treeFile::Node *nodes = nullptr;
+    const char *names = nullptr;
+};
+#endif
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef FACTORY_METHOD_FACTORY_METHOD_H
+#define FACTORY_METHOD_FACTORY_METHOD_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+/*
+ * Product
+ * products implement the same interface so that the classes can refer
+ * to the interface not the concrete product
+ */
+class Product {
+   public:
+    virtual ~Product() = default;
+
+    virtual std::string getName() const = 0;
+    // ...
+};
+
+/*
+ * Concrete Products A and B
+ * define products to be created; they are final so calls on products
+ * of a known type are resolved statically
+ */
+class ConcreteProductA final : public Product {
+   public:
+    std::string getName() const override { return "ConcreteProductA"; }
+    // ...
+};
+
+class ConcreteProductB final : public Product {
+   public:
+    std::string getName() const override { return "ConcreteProductB"; }
+};
+
+/*
+ * Product Batch
+ * stores products by value in one contiguous bucket per concrete type,
+ * so iterating a batch is a linear walk instead of pointer chasing and
+ * forEach calls every product without virtual dispatch
+ */
+class ProductBatch {
+   public:
+    template <typename ConcreteProduct>
+    void add(std::size_t count) {
+        std::vector<ConcreteProduct> &bucket =
+            std::get<std::vector<ConcreteProduct>>(buckets);
+        bucket.resize(bucket.size() + count);
+    }
+
+    template <typename ConcreteProduct>
+    const std::vector<ConcreteProduct> &get() const {
+        return std::get<std::vector<ConcreteProduct>>(buckets);
+    }
+
+    template <typename Function>
+    void forEach(Function function) const {
+        std::apply(
+            [&function](const auto &... bucket) {
+                (..., forEachIn(bucket, function));
+            },
+            buckets);
+    }
+
+    std::size_t size() const {
+        return std::apply(
+            [](const auto &... bucket) {
+                return (std::size_t{0} + ... + bucket.size());
+            },
+            buckets);
+    }
+
+   private:
+    template <typename Bucket, typename Function>
+    static void forEachIn(const Bucket &bucket, Function &function) {
+        for (const auto &product : bucket) function(product);
+    }
+
+    std::tuple<std::vector<ConcreteProductA>, std::vector<ConcreteProductB>>
+        buckets;
+};
+
+/*
+ * Creator
+ * declares the factory method that is supposed to return an
+ * object of a Product class, and a batch variant that appends
+ * count products to a ProductBatch
+ */
+class Creator {
+   public:
+    virtual ~Creator() = default;
+
+    virtual std::shared_ptr<Product> factoryMethod() const = 0;
+    virtual void factoryMethod(std::size_t count, ProductBatch &batch) const = 0;
+};
+
+/*
+ * Concrete Creators A and B
+ * implements factory method that is responsible for creating
+ * concrete products ie. it is classes that has
+ * the knowledge of how to create the products
+ */
+class ConcreteCreatorA : public Creator {
+   public:
+    std::shared_ptr<Product> factoryMethod() const override {
+        std::shared_ptr<Product> product = std::make_shared<ConcreteProductA>();
+        return product;
+    }
+    void factoryMethod(std::size_t count, ProductBatch &batch) const override {
+        batch.add<ConcreteProductA>(count);
+    }
+};
+
+class ConcreteCreatorB : public Creator {
+   public:
+    std::shared_ptr<Product> factoryMethod() const override {
+        std::shared_ptr<Product> product = std::make_shared<ConcreteProductB>();
+        return product;
+    }
+    void factoryMethod(std::size_t count, ProductBatch &batch) const override {
+        batch.add<ConcreteProductB>(count);
+    }
+};
+
+/*
+ * Alternative realization factoryMethod
+ * creators register themselves into a dense table indexed by Type, so
+ * creating a product is one indirect call and adding a product type does
+ * not touch a central switch; unknown types are reported through an
+ * error code instead of an exception
+ */
+namespace alternative {
+enum class Type { ConcreteProductA = 1, ConcreteProductB, Count };
+
+class Registry {
+   public:
+    using CreateFunction = std::shared_ptr<Product> (*)();
+
+    Registry(Registry const &) = delete;
+    Registry &operator=(Registry const &) = delete;
+
+    static Registry &getInstance() {
+        static Registry instance;
+        return instance;
+    }
+
+    bool add(Type type, CreateFunction create) {
+        const std::size_t index = static_cast<std::size_t>(type);
+        if (index >= creators.size() || creators[index] != nullptr)
+            return false;
+        creators[index] = create;
+        return true;
+    }
+
+    std::shared_ptr<Product> create(Type type, std::error_code &error) const {
+        const std::size_t index = static_cast<std::size_t>(type);
+        if (index >= creators.size() || creators[index] == nullptr) {
+            error = std::make_error_code(std::errc::invalid_argument);
+            return nullptr;
+        }
+        error.clear();
+        return creators[index]();
+    }
+
+   private:
+    Registry() = default;
+
+    std::array<CreateFunction, static_cast<std::size_t>(Type::Count)> creators{};
+};
+
+template <typename ConcreteProduct, Type type>
+class Registrar {
+   public:
+    Registrar() {
+        Registry::getInstance().add(type, []() -> std::shared_ptr<Product> {
+            return std::make_shared<ConcreteProduct>();
+        });
+    }
+};
+
+inline Registrar<ConcreteProductA, Type::ConcreteProductA> registrarA;
+inline Registrar<ConcreteProductB, Type::ConcreteProductB> registrarB;
+
+class Creator {
+   public:
+    virtual ~Creator() = default;
+
+    virtual std::shared_ptr<Product> factoryMethod(
+        Type type, std::error_code &error) const = 0;
+};
+
+class ConcreteCreator : public Creator {
+   public:
+    std::shared_ptr<Product> factoryMethod(
+        Type type, std::error_code &error) const override {
+        return Registry::getInstance().create(type, error);
+    }
+};
+}  // namespace alternative
+
+#endif
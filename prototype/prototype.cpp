@@ -1,67 +1,7 @@
 #include <iostream>
 #include <memory>
-#include <string>
-#include <unordered_map>
 
-enum class Type { PROTOTYPE_A = 0, PROTOTYPE_B };
-
-/*
- * Prototype
- * declares an interface for cloning itself
- */
-class Prototype {
-   public:
-    virtual ~Prototype() = default;
-
-    virtual std::shared_ptr<Prototype> clone() const = 0;
-    virtual std::string type() const = 0;
-    // ...
-};
-
-/*
- * Concrete Prototype A and B
- * implement an operation for cloning itself
- */
-class ConcretePrototypeA : public Prototype {
-   public:
-    std::shared_ptr<Prototype> clone() const override {
-        return std::make_shared<ConcretePrototypeA>(*this);
-    }
-
-    std::string type() const override { return "ConcretePrototypeA"; }
-    // ...
-};
-
-class ConcretePrototypeB : public Prototype {
-   public:
-    std::shared_ptr<Prototype> clone() const override {
-        return std::make_shared<ConcretePrototypeB>(*this);
-    }
-
-    std::string type() const override { return "ConcretePrototypeB"; }
-    // ...
-};
-
-/*
- * Client
- * creates a new object by asking a prototype to clone itself
- */
-class Client {
-   public:
-    void init() {
-        prototypes[Type::PROTOTYPE_A] = std::make_shared<ConcretePrototypeA>();
-        prototypes[Type::PROTOTYPE_B] = std::make_shared<ConcretePrototypeB>();
-    }
-
-    std::shared_ptr<Prototype> make(Type type) {
-        return prototypes[type]->clone();
-    }
-    // ...
-
-   private:
-    std::unordered_map<Type, std::shared_ptr<Prototype>>
-        prototypes;
-};
+#include "prototype.h"
 
 int main(){
     Client client;
@@ -72,4 +12,18 @@ int main(){
 
     prototype = client.make(Type::PROTOTYPE_B);
     std::cout << "Prototype: " << prototype->type() << "\n";
+
+    auto original = std::make_shared<ConcretePrototypeA>();
+    auto copy = std::static_pointer_cast<ConcretePrototypeA>(original->clone());
+    std::cout << "Clone shares state: " << copy->sharesState(*original) << "\n";
+    copy->setSample(0, 42.0);
+    std::cout << "Clone shares state after write: "
+              << copy->sharesState(*original) << "\n";
+
+    CloneBlock clones = client.cloneN(Type::PROTOTYPE_B, 1000);
+    std::cout << "Block of " << clones.size() << " x " << clones[999].type()
+              << "\n";
+
+    PoolStats stats = client.getStats(Type::PROTOTYPE_A);
+    std::cout << "Pool hit rate: " << stats.hitRate() * 100 << "%\n";
 }
\ No newline at end of file
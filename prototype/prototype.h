@@ -0,0 +1,428 @@
+#ifndef PROTOTYPE_PROTOTYPE_H
+#define PROTOTYPE_PROTOTYPE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class Type { PROTOTYPE_A = 0, PROTOTYPE_B, COUNT };
+
+class Prototype;
+
+/*
+ * Clone Block
+ * handle to n clones placement-constructed in a single allocation that
+ * also holds the refcount, so copies of the handle keep the clones alive
+ * and batch cloning costs one allocation whatever n is
+ */
+class CloneBlock {
+   public:
+    template <typename ConcretePrototype>
+    static CloneBlock create(const ConcretePrototype &prototype, std::size_t n);
+
+    CloneBlock(const CloneBlock &other) : header(other.header) {
+        if (header) header->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    CloneBlock(CloneBlock &&other) noexcept : header(other.header) {
+        other.header = nullptr;
+    }
+    CloneBlock &operator=(CloneBlock other) noexcept {
+        std::swap(header, other.header);
+        return *this;
+    }
+    ~CloneBlock() {
+        if (header && header->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            header->destroy(header);
+    }
+
+    std::size_t size() const { return header ? header->count : 0; }
+    Prototype &operator[](std::size_t i) const { return *header->at(header, i); }
+
+   private:
+    struct Header {
+        std::atomic<std::size_t> refs;
+        std::size_t count;
+        Prototype *(*at)(Header *, std::size_t);
+        void (*destroy)(Header *);
+    };
+
+    template <typename ConcretePrototype>
+    static constexpr std::size_t offset() {
+        constexpr std::size_t align = alignof(ConcretePrototype);
+        return (sizeof(Header) + align - 1) / align * align;
+    }
+
+    template <typename ConcretePrototype>
+    static ConcretePrototype *first(Header *header) {
+        return reinterpret_cast<ConcretePrototype *>(
+            reinterpret_cast<std::byte *>(header) + offset<ConcretePrototype>());
+    }
+
+    explicit CloneBlock(Header *header) : header(header) {}
+
+    Header *header;
+};
+
+template <typename ConcretePrototype>
+CloneBlock CloneBlock::create(const ConcretePrototype &prototype,
+                              std::size_t n) {
+    static_assert(alignof(ConcretePrototype) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "over-aligned prototypes are not supported");
+
+    void *memory = ::operator new(offset<ConcretePrototype>() +
+                                  n * sizeof(ConcretePrototype));
+    Header *header = new (memory) Header{
+        {1},
+        0,
+        [](Header *header, std::size_t i) -> Prototype * {
+            return first<ConcretePrototype>(header) + i;
+        },
+        [](Header *header) {
+            ConcretePrototype *clones = first<ConcretePrototype>(header);
+            for (std::size_t i = header->count; i > 0; --i)
+                clones[i - 1].~ConcretePrototype();
+            header->~Header();
+            ::operator delete(header);
+        }};
+
+    CloneBlock block(header);
+    ConcretePrototype *clones = first<ConcretePrototype>(header);
+    for (; header->count < n; ++header->count)
+        new (clones + header->count) ConcretePrototype(prototype);
+    return block;
+}
+
+/*
+ * Prototype
+ * declares an interface for cloning itself, one clone at a time or
+ * n clones into one contiguous block
+ */
+class Prototype {
+   public:
+    virtual ~Prototype() = default;
+
+    virtual std::shared_ptr<Prototype> clone() const = 0;
+    virtual CloneBlock cloneN(std::size_t n) const = 0;
+    virtual std::string type() const = 0;
+    // ...
+};
+
+/*
+ * Copy On Write
+ * keeps state in a refcounted block that copies share; read() never
+ * copies and the first write() on a shared block makes a private copy,
+ * so copying is a refcount increment however heavy the state is; the
+ * uniqueness check is an acquire load that pairs with the release in
+ * the destructor, so a copy dropped on another thread has finished
+ * reading before write() changes the block in place
+ */
+template <typename State>
+class CopyOnWrite {
+   public:
+    explicit CopyOnWrite(State state = State{})
+        : block(new Block{{1}, std::move(state)}) {}
+
+    CopyOnWrite(const CopyOnWrite &other) : block(other.block) {
+        block->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    CopyOnWrite &operator=(CopyOnWrite other) noexcept {
+        std::swap(block, other.block);
+        return *this;
+    }
+    ~CopyOnWrite() { release(block); }
+
+    const State &read() const { return block->state; }
+
+    State &write() {
+        if (block->refs.load(std::memory_order_acquire) != 1) {
+            Block *copy = new Block{{1}, block->state};
+            release(block);
+            block = copy;
+        }
+        return block->state;
+    }
+
+    bool shares(const CopyOnWrite &other) const { return block == other.block; }
+
+   private:
+    struct Block {
+        std::atomic<std::size_t> refs;
+        State state;
+    };
+
+    static void release(Block *block) {
+        if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete block;
+    }
+
+    Block *block;
+};
+
+/*
+ * Prototype State
+ * stands in for the heavy data a real prototype carries
+ */
+struct PrototypeState {
+    std::string description;
+    std::vector<double> samples;
+};
+
+/*
+ * Concrete Prototype A and B
+ * implement an operation for cloning itself; their state is copy on
+ * write, so a clone shares it with the prototype until it is modified
+ */
+class ConcretePrototypeA : public Prototype {
+   public:
+    ConcretePrototypeA()
+        : state(PrototypeState{"A", std::vector<double>(4096, 1.0)}) {}
+
+    std::shared_ptr<Prototype> clone() const override {
+        return std::make_shared<ConcretePrototypeA>(*this);
+    }
+    CloneBlock cloneN(std::size_t n) const override {
+        return CloneBlock::create(*this, n);
+    }
+
+    std::string type() const override { return "ConcretePrototypeA"; }
+
+    double getSample(std::size_t i) const { return state.read().samples[i]; }
+    void setSample(std::size_t i, double value) {
+        state.write().samples[i] = value;
+    }
+    bool sharesState(const ConcretePrototypeA &other) const {
+        return state.shares(other.state);
+    }
+    // ...
+
+   private:
+    CopyOnWrite<PrototypeState> state;
+};
+
+class ConcretePrototypeB : public Prototype {
+   public:
+    ConcretePrototypeB()
+        : state(PrototypeState{"B", std::vector<double>(4096, 2.0)}) {}
+
+    std::shared_ptr<Prototype> clone() const override {
+        return std::make_shared<ConcretePrototypeB>(*this);
+    }
+    CloneBlock cloneN(std::size_t n) const override {
+        return CloneBlock::create(*this, n);
+    }
+
+    std::string type() const override { return "ConcretePrototypeB"; }
+
+    double getSample(std::size_t i) const { return state.read().samples[i]; }
+    void setSample(std::size_t i, double value) {
+        state.write().samples[i] = value;
+    }
+    bool sharesState(const ConcretePrototypeB &other) const {
+        return state.shares(other.state);
+    }
+    // ...
+
+   private:
+    CopyOnWrite<PrototypeState> state;
+};
+
+/*
+ * Clone Pool
+ * keeps clones of one prototype ready ahead of time; pop() hands out a
+ * ready clone or clones on the spot when the pool ran dry, and reports
+ * when the pool dropped below its low-water mark so it can be refilled
+ * off the caller's path
+ */
+struct PoolStats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t refills = 0;
+    std::chrono::nanoseconds maxRefillLag{0};
+    std::chrono::nanoseconds totalRefillLag{0};
+
+    double hitRate() const {
+        std::size_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+};
+
+class ClonePool {
+   public:
+    ClonePool(std::shared_ptr<Prototype> prototype, std::size_t lowWater,
+              std::size_t capacity)
+        : prototype(std::move(prototype)),
+          lowWater(lowWater),
+          capacity(capacity) {}
+
+    std::shared_ptr<Prototype> pop(bool &needsRefill) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (ready.empty()) {
+            ++stats.misses;
+            needsRefill = markLow();
+            lock.unlock();
+            return prototype->clone();
+        }
+
+        ++stats.hits;
+        std::shared_ptr<Prototype> clone = std::move(ready.back());
+        ready.pop_back();
+        needsRefill = ready.size() < lowWater && markLow();
+        return clone;
+    }
+
+    // clones up to capacity outside the lock and records how long the
+    // pool waited below its low-water mark
+    void refill() {
+        std::size_t missing;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            missing = capacity - ready.size();
+        }
+
+        std::vector<std::shared_ptr<Prototype>> clones;
+        clones.reserve(missing);
+        for (std::size_t i = 0; i < missing; ++i)
+            clones.push_back(prototype->clone());
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::shared_ptr<Prototype> &clone : clones)
+            if (ready.size() < capacity) ready.push_back(std::move(clone));
+
+        if (low) {
+            std::chrono::nanoseconds lag =
+                std::chrono::steady_clock::now() - lowSince;
+            stats.totalRefillLag += lag;
+            if (lag > stats.maxRefillLag) stats.maxRefillLag = lag;
+            ++stats.refills;
+            low = false;
+        }
+    }
+
+    PoolStats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    const Prototype &getPrototype() const { return *prototype; }
+
+   private:
+    bool markLow() {
+        if (low) return false;
+        low = true;
+        lowSince = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    std::shared_ptr<Prototype> prototype;
+    std::size_t lowWater;
+    std::size_t capacity;
+
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<Prototype>> ready;
+    bool low = false;
+    std::chrono::steady_clock::time_point lowSince;
+    PoolStats stats;
+};
+
+/*
+ * Client
+ * creates a new object by asking a prototype to clone itself; the
+ * prototypes sit in a dense array indexed by Type and each has a pool
+ * of clones that a background thread refills above the low-water mark
+ */
+class Client {
+   public:
+    Client() = default;
+    Client(Client const &) = delete;
+    Client &operator=(Client const &) = delete;
+
+    ~Client() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_one();
+        if (refiller.joinable()) refiller.join();
+    }
+
+    // sets the pools up and starts the refiller on the first call; later
+    // calls keep the pools, whose sizes are fixed by the first call, and
+    // only ask the refiller to top them up
+    void init(std::size_t lowWater = 16, std::size_t capacity = 64) {
+        bool first = false;
+        std::call_once(initialized, [&]() {
+            pools[index(Type::PROTOTYPE_A)] = std::make_unique<ClonePool>(
+                std::make_shared<ConcretePrototypeA>(), lowWater, capacity);
+            pools[index(Type::PROTOTYPE_B)] = std::make_unique<ClonePool>(
+                std::make_shared<ConcretePrototypeB>(), lowWater, capacity);
+
+            for (std::unique_ptr<ClonePool> &pool : pools) pool->refill();
+            refiller = std::thread([this]() { refill(); });
+            first = true;
+        });
+        if (!first) requestRefill();
+    }
+
+    std::shared_ptr<Prototype> make(Type type) {
+        bool needsRefill = false;
+        std::shared_ptr<Prototype> clone = pools[index(type)]->pop(needsRefill);
+        if (needsRefill) requestRefill();
+        return clone;
+    }
+
+    CloneBlock cloneN(Type type, std::size_t n) const {
+        return pools[index(type)]->getPrototype().cloneN(n);
+    }
+
+    PoolStats getStats(Type type) const {
+        return pools[index(type)]->getStats();
+    }
+    // ...
+
+   private:
+    static std::size_t index(Type type) {
+        return static_cast<std::size_t>(type);
+    }
+
+    void requestRefill() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            requested = true;
+        }
+        wake.notify_one();
+    }
+
+    void refill() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this]() { return stop || requested; });
+            if (stop) return;
+            requested = false;
+
+            lock.unlock();
+            for (std::unique_ptr<ClonePool> &pool : pools) pool->refill();
+            lock.lock();
+        }
+    }
+
+    std::array<std::unique_ptr<ClonePool>, static_cast<std::size_t>(Type::COUNT)>
+        pools;
+
+    std::once_flag initialized;
+    std::thread refiller;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool requested = false;
+    bool stop = false;
+};
+
+#endif
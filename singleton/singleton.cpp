@@ -1,32 +1,271 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <future>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "singleton.h"
 
 /*
- * Meyers Singleton
- * has private static variable to hold one instance of the class
- * and method which gives us a way to instantiate the class
+ * Sharded Singleton
+ * a global counter split into cache-line aligned shards; each thread is
+ * assigned one shard on first use and writes only there, so writers on
+ * different cores do not share a cache line; read() sums every shard on
+ * demand and readApproximate() returns a cached sum at most maxAge old
  */
-class Singleton {
+template <typename Tag>
+class ShardedCounter {
    public:
-    Singleton(Singleton const &) = delete;
-    Singleton &operator=(Singleton const &) = delete;
+    static constexpr std::size_t shards = 64;
+    static constexpr std::size_t cacheLine = 64;
+
+    ShardedCounter(ShardedCounter const &) = delete;
+    ShardedCounter &operator=(ShardedCounter const &) = delete;
 
-    static Singleton &getInstance(const std::string &value) {
-        static Singleton instance{value};
+    static ShardedCounter &getInstance() {
+        static ShardedCounter instance;
         return instance;
     }
 
-    std::string getValue() const { return value; }
+    void add(long long n) {
+        thread_local std::size_t shard =
+            nextShard.fetch_add(1, std::memory_order_relaxed) % shards;
+        values[shard].value.fetch_add(n, std::memory_order_relaxed);
+    }
 
-   protected:
-    Singleton() = default;
-    Singleton(const std::string value) : value(value) {}
-    ~Singleton() = default;
+    long long read() const {
+        long long sum = 0;
+        for (const Shard &shard : values)
+            sum += shard.value.load(std::memory_order_relaxed);
+
+        cachedSum.store(sum, std::memory_order_relaxed);
+        cachedAt.store(now(), std::memory_order_relaxed);
+        return sum;
+    }
+
+    long long readApproximate(
+        std::chrono::nanoseconds maxAge = std::chrono::milliseconds(1)) const {
+        if (now() - cachedAt.load(std::memory_order_relaxed) > maxAge.count())
+            return read();
+        return cachedSum.load(std::memory_order_relaxed);
+    }
 
    protected:
-    std::string value;
-    // ...
+    ShardedCounter() = default;
+    ~ShardedCounter() = default;
+
+   private:
+    struct alignas(cacheLine) Shard {
+        std::atomic<long long> value{0};
+    };
+
+    static long long now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    std::array<Shard, shards> values;
+    std::atomic<std::size_t> nextShard{0};
+    alignas(cacheLine) mutable std::atomic<long long> cachedSum{0};
+    mutable std::atomic<long long> cachedAt{0};
+};
+
+/*
+ * Singleton Registry
+ * knows how to initialize each registered singleton and which singletons
+ * it depends on; initializeAll() builds them at startup on a number of
+ * threads, each one once all of its dependencies are built, and reports
+ * how long every initialization took; ensure() is the lazy fallback that
+ * builds one singleton and its dependencies on the calling thread
+ */
+struct InitReport {
+    std::string name;
+    std::chrono::nanoseconds time;
+};
+
+class SingletonRegistry {
+   public:
+    SingletonRegistry(SingletonRegistry const &) = delete;
+    SingletonRegistry &operator=(SingletonRegistry const &) = delete;
+
+    static SingletonRegistry &getInstance() {
+        static SingletonRegistry instance;
+        return instance;
+    }
+
+    void add(const std::string &name, std::vector<std::string> dependencies,
+             std::function<void()> init) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (indices.count(name))
+            throw std::runtime_error("singleton already registered: " + name);
+
+        std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+        entry->name = name;
+        entry->dependencies = std::move(dependencies);
+        entry->init = std::move(init);
+
+        indices[name] = entries.size();
+        entries.push_back(std::move(entry));
+    }
+
+    void ensure(const std::string &name) {
+        std::size_t i;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            i = indexOf(name);
+        }
+        Graph graph = snapshot();
+        std::vector<bool> visiting(graph.entries.size());
+        ensure(graph, i, visiting);
+    }
+
+    // the first init function that throws stops the remaining work and
+    // its exception is rethrown here, on the calling thread
+    std::vector<InitReport> initializeAll(
+        std::size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+        if (threads == 0)
+            throw std::invalid_argument("initializeAll needs a thread");
+
+        Graph graph = snapshot();
+        const std::size_t count = graph.entries.size();
+        std::vector<std::vector<std::size_t>> dependents(count);
+        std::vector<std::size_t> waiting(count);
+        for (std::size_t i = 0; i < count; ++i)
+            for (std::size_t dependency : graph.dependencies[i]) {
+                dependents[dependency].push_back(i);
+                ++waiting[i];
+            }
+
+        std::mutex queueMutex;
+        std::condition_variable wake;
+        std::deque<std::size_t> ready;
+        std::size_t active = 0;
+        std::size_t done = 0;
+        std::exception_ptr error;
+        for (std::size_t i = 0; i < count; ++i)
+            if (waiting[i] == 0) ready.push_back(i);
+
+        auto work = [&]() {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            for (;;) {
+                wake.wait(lock, [&]() {
+                    return error || !ready.empty() || active == 0;
+                });
+                if (error || ready.empty()) return;
+
+                std::size_t i = ready.front();
+                ready.pop_front();
+                ++active;
+                lock.unlock();
+                std::exception_ptr failure;
+                try {
+                    initialize(*graph.entries[i]);
+                } catch (...) {
+                    failure = std::current_exception();
+                }
+                lock.lock();
+                --active;
+                if (failure) {
+                    if (!error) error = failure;
+                    wake.notify_all();
+                    return;
+                }
+                ++done;
+                for (std::size_t dependent : dependents[i])
+                    if (--waiting[dependent] == 0) ready.push_back(dependent);
+                wake.notify_all();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t i = 0; i < threads; ++i) workers.emplace_back(work);
+        for (std::thread &worker : workers) worker.join();
+
+        if (error) std::rethrow_exception(error);
+        if (done != count)
+            throw std::runtime_error("singleton dependencies form a cycle");
+
+        std::vector<InitReport> reports;
+        for (const Entry *entry : graph.entries)
+            reports.push_back({entry->name, entry->time});
+        return reports;
+    }
+
+   private:
+    struct Entry {
+        std::string name;
+        std::vector<std::string> dependencies;
+        std::function<void()> init;
+        std::once_flag once;
+        std::chrono::nanoseconds time{0};
+    };
+
+    // entries are never removed and live behind stable pointers, so a
+    // snapshot taken under the lock stays valid while add() keeps
+    // registering; init functions run without the lock held and may
+    // call ensure() themselves
+    struct Graph {
+        std::vector<Entry *> entries;
+        std::vector<std::vector<std::size_t>> dependencies;
+    };
+
+    SingletonRegistry() = default;
+
+    Graph snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        Graph graph;
+        for (const std::unique_ptr<Entry> &entry : entries) {
+            graph.entries.push_back(entry.get());
+            graph.dependencies.emplace_back();
+            for (const std::string &dependency : entry->dependencies)
+                graph.dependencies.back().push_back(indexOf(dependency));
+        }
+        return graph;
+    }
+
+    std::size_t indexOf(const std::string &name) const {
+        auto i = indices.find(name);
+        if (i == indices.end())
+            throw std::runtime_error("unknown singleton: " + name);
+        return i->second;
+    }
+
+    void ensure(const Graph &graph, std::size_t i, std::vector<bool> &visiting) {
+        if (visiting[i])
+            throw std::runtime_error("singleton dependencies form a cycle");
+
+        visiting[i] = true;
+        for (std::size_t dependency : graph.dependencies[i])
+            ensure(graph, dependency, visiting);
+        visiting[i] = false;
+        initialize(*graph.entries[i]);
+    }
+
+    static void initialize(Entry &entry) {
+        std::call_once(entry.once, [&entry]() {
+            auto start = std::chrono::steady_clock::now();
+            entry.init();
+            entry.time = std::chrono::steady_clock::now() - start;
+        });
+    }
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::size_t> indices;
+    std::vector<std::unique_ptr<Entry>> entries;
 };
 
 int main() {
@@ -35,6 +274,7 @@ int main() {
 
     std::cout << singleton1.getValue() << "\n";
     std::cout << singleton2.getValue() << "\n";
+    std::cout << Singleton::getInstance().getValue() << "\n";
 
     auto foo = []() {
         Singleton &singleton = Singleton::getInstance("foo");
@@ -50,4 +290,24 @@ int main() {
     std::async(std::launch::async, foo);
     std::async(std::launch::async, bar);
     std::async(std::launch::async, bar);
+
+    struct Requests {};
+    auto count = []() {
+        for (int i = 0; i < 1000; ++i)
+            ShardedCounter<Requests>::getInstance().add(1);
+    };
+    std::future<void> counter1 = std::async(std::launch::async, count);
+    std::future<void> counter2 = std::async(std::launch::async, count);
+    counter1.get();
+    counter2.get();
+    std::cout << "Requests: " << ShardedCounter<Requests>::getInstance().read()
+              << "\n";
+
+    SingletonRegistry &registry = SingletonRegistry::getInstance();
+    registry.add("singleton", {}, []() { Singleton::getInstance("foo"); });
+    registry.add("requests", {"singleton"},
+                 []() { ShardedCounter<Requests>::getInstance(); });
+    for (const InitReport &report : registry.initializeAll())
+        std::cout << "Initialized " << report.name << " in "
+                  << report.time.count() << " ns\n";
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef SINGLETON_SINGLETON_H
+#define SINGLETON_SINGLETON_H
+
+#include <string>
+
+/*
+ * Meyers Singleton
+ * has private static variable to hold one instance of the class
+ * and method which gives us a way to instantiate the class;
+ * getInstance() without an argument caches the reference in a
+ * thread_local, so after its first call a thread only checks its own
+ * guard instead of the shared one
+ */
+class Singleton {
+   public:
+    Singleton(Singleton const &) = delete;
+    Singleton &operator=(Singleton const &) = delete;
+
+    static Singleton &getInstance(const std::string &value) {
+        return instance(&value);
+    }
+
+    static Singleton &getInstance() {
+        thread_local Singleton &cached = instance(nullptr);
+        return cached;
+    }
+
+    std::string getValue() const { return value; }
+
+   protected:
+    static Singleton &instance(const std::string *value) {
+        static Singleton instance{value ? *value : std::string()};
+        return instance;
+    }
+
+    Singleton() = default;
+    Singleton(const std::string value) : value(value) {}
+    ~Singleton() = default;
+
+   protected:
+    std::string value;
+    // ...
+};
+
+#endif
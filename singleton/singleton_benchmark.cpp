@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "singleton.h"
+
+/*
+ * Benchmark of Singleton::getInstance under growing thread counts:
+ * every thread calls one accessor in a tight loop, like the std::async
+ * calls in the singleton example; cache misses of the whole run are read
+ * from the hardware counters on Linux as a measure of cache-line traffic
+ *
+ * usage: singleton_benchmark [calls per thread]
+ */
+
+/*
+ * Cache Miss Counter
+ * counts hardware cache misses of this process and of the threads it
+ * starts while enabled; reports nothing where perf events are unavailable
+ */
+class CacheMissCounter {
+   public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    CacheMissCounter(CacheMissCounter const &) = delete;
+    CacheMissCounter &operator=(CacheMissCounter const &) = delete;
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    std::uint64_t stop() {
+        std::uint64_t count = 0;
+#ifdef __linux__
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+        return count;
+    }
+
+   private:
+    int fd = -1;
+};
+
+template <typename Accessor>
+void run(const char *name, std::size_t threads, std::size_t calls,
+         Accessor accessor) {
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> checksum{0};
+    std::vector<std::thread> workers;
+
+    CacheMissCounter misses;
+    misses.start();
+    for (std::size_t t = 0; t < threads; ++t)
+        workers.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            std::uintptr_t sum = 0;
+            for (std::size_t i = 0; i < calls; ++i)
+                sum += reinterpret_cast<std::uintptr_t>(&accessor());
+            checksum.fetch_add(sum, std::memory_order_relaxed);
+        });
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread &worker : workers) worker.join();
+    auto stop = std::chrono::steady_clock::now();
+    std::uint64_t missCount = misses.stop();
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    double total = static_cast<double>(threads * calls);
+    std::cout << name << ", " << threads << " threads: " << total / seconds / 1e6
+              << " Mcalls/s";
+    if (misses.available())
+        std::cout << ", " << static_cast<double>(missCount) / total
+                  << " cache misses/call";
+    std::cout << " (checksum " << checksum.load() % 1000 << ")\n";
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t calls = argc > 1 ? std::stoul(argv[1]) : 10000000;
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const std::string foo = "foo";
+    Singleton::getInstance(foo);
+
+    for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2) {
+        run("getInstance(\"foo\")", threads, calls,
+            []() -> Singleton & { return Singleton::getInstance("foo"); });
+        run("getInstance(foo)", threads, calls,
+            [&foo]() -> Singleton & { return Singleton::getInstance(foo); });
+        run("getInstance()", threads, calls,
+            []() -> Singleton & { return Singleton::getInstance(); });
+    }
+}